@@ -0,0 +1,156 @@
+/*
+ * benchmark/DecayBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/bank/ExactImportanceDiffusion.h>
+#include <opencog/attentionbank/bank/StochasticImportanceDiffusion.h>
+
+using namespace opencog;
+using namespace opencog::ecan;
+
+typedef std::chrono::steady_clock bclock;
+
+struct Result
+{
+    double nanos = 0;       // Total time spent in elapsed_time()
+    double abs_error = 0;   // Sum of |estimate - truth|, seconds
+    size_t samples = 0;     // Calls whose truth was known
+};
+
+static void report(const char* name, const Result& r, size_t calls,
+                   size_t bytes)
+{
+    printf("%-11s %10.1f ns/call %12.4f s mean abs error %12zu bytes\n",
+           name, r.nanos / calls,
+           r.samples ? r.abs_error / r.samples : 0.0, bytes);
+}
+
+/**
+ * Compare the two elapsed-time calculators on a large AtomSpace in which
+ * most atoms are idle. Each step draws a batch of atoms, mostly from a
+ * small hot set and occasionally from the whole AtomSpace, hands the same
+ * batch to both calculators, and checks their answers against the true
+ * time since each atom was last drawn.
+ */
+int main(int argc, char** argv)
+{
+    size_t num_atoms = 1000000;
+    size_t num_hot = 10000;
+    double seconds = 5.0;
+    const size_t batch = 100;
+    const double hot_ratio = 0.95;
+
+    if (1 < argc) num_atoms = strtoul(argv[1], nullptr, 10);
+    if (2 < argc) num_hot = strtoul(argv[2], nullptr, 10);
+    if (3 < argc) seconds = strtod(argv[3], nullptr);
+    if (num_hot > num_atoms) num_hot = num_atoms;
+
+    AtomSpace as;
+    AttentionBank& bank(attentionbank(&as));
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> sti_dist(0, 1000);
+
+    printf("Populating %zu atoms (%zu hot) ...\n", num_atoms, num_hot);
+    HandleSeq atoms;
+    atoms.reserve(num_atoms);
+    for (size_t i = 0; i < num_atoms; i++) {
+        Handle h = as.add_node(CONCEPT_NODE, "decay-" + std::to_string(i));
+        bank.set_sti(h, sti_dist(rng));
+        atoms.push_back(h);
+    }
+
+    StochasticDiffusionAmountCalculator sdac(&bank.getImportance());
+    ExactDiffusionAmountCalculator edac(&as);
+
+    std::uniform_int_distribution<size_t> hot_dist(0, num_hot - 1);
+    std::uniform_int_distribution<size_t> all_dist(0, num_atoms - 1);
+    std::bernoulli_distribution is_hot(hot_ratio);
+
+    std::unordered_map<Handle, bclock::time_point> truth;
+    Result stochastic, exact;
+    size_t calls = 0;
+    HandleSeq sample(batch);
+
+    auto end = bclock::now() + std::chrono::duration_cast<bclock::duration>(
+            std::chrono::duration<double>(seconds));
+
+    while (bclock::now() < end) {
+        for (Handle& h : sample)
+            h = atoms[is_hot(rng) ? hot_dist(rng) : all_dist(rng)];
+
+        std::vector<float> s_est(batch), e_est(batch);
+
+        auto t0 = bclock::now();
+        for (size_t i = 0; i < batch; i++)
+            s_est[i] = sdac.elapsed_time(sample[i]);
+        auto t1 = bclock::now();
+        for (size_t i = 0; i < batch; i++)
+            e_est[i] = edac.elapsed_time(sample[i]);
+        auto t2 = bclock::now();
+
+        stochastic.nanos += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        exact.nanos += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        calls += batch;
+
+        for (size_t i = 0; i < batch; i++) {
+            auto it = truth.find(sample[i]);
+            if (it != truth.end()) {
+                double real = std::chrono::duration<double>(t1 - it->second).count();
+                stochastic.abs_error += std::fabs(s_est[i] - real);
+                exact.abs_error += std::fabs(e_est[i] - real);
+                stochastic.samples++;
+                exact.samples++;
+                it->second = t1;
+            } else {
+                truth.emplace(sample[i], t1);
+            }
+        }
+
+        // Leave the atoms alone for a while, as an agent would
+        // between two of its cycles.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // A hash-table node holds the key, the tick, a next pointer and
+    // the cached hash.
+    size_t node_bytes = sizeof(Handle) + sizeof(ExactDiffusionAmountCalculator::tick_t)
+                        + sizeof(void*) + sizeof(size_t);
+
+    printf("%zu calls per calculator, %zu distinct atoms visited\n",
+           calls, truth.size());
+    report("stochastic", stochastic, calls,
+           sizeof(StochasticDiffusionAmountCalculator));
+    report("exact", exact, calls,
+           sizeof(ExactDiffusionAmountCalculator) + edac.size() * node_bytes);
+
+    return 0;
+}
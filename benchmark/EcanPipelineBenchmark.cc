@@ -0,0 +1,173 @@
+/*
+ * benchmark/EcanPipelineBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include <opencog/attention/AFImportanceDiffusionAgent.h>
+#include <opencog/attention/AFRentCollectionAgent.h>
+#include <opencog/attention/AttentionParamQuery.h>
+#include <opencog/attention/EcanPipelineAgent.h>
+#include <opencog/attention/WAImportanceDiffusionAgent.h>
+#include <opencog/attention/WARentCollectionAgent.h>
+
+using namespace opencog;
+
+typedef std::chrono::steady_clock bclock;
+
+/**
+ * Gives the same atoms the same STI before each run.
+ */
+static void stimulate(AttentionBank& bank, const HandleSeq& hot)
+{
+    for (const Handle& h : hot)
+        bank.set_sti(h, 1000);
+}
+
+/**
+ * Runs each agent in a thread of its own, as start-ecan does, for the
+ * given time. A full ECAN cycle has been done once every agent has run,
+ * so the number of cycles is that of the agent that ran least often.
+ */
+static double run_agents(std::vector<Agent*> agents, double seconds)
+{
+    std::atomic<bool> stop(false);
+    std::vector<size_t> runs(agents.size(), 0);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < agents.size(); i++) {
+        threads.emplace_back([&, i]() {
+            while (not stop) {
+                agents[i]->run();
+                runs[i]++;
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (std::thread& t : threads) t.join();
+
+    return *std::min_element(runs.begin(), runs.end()) / seconds;
+}
+
+static double run_pipeline(Agent& pipeline, double seconds)
+{
+    size_t runs = 0;
+    auto end = bclock::now() + std::chrono::duration_cast<bclock::duration>(
+            std::chrono::duration<double>(seconds));
+    while (bclock::now() < end) {
+        pipeline.run();
+        runs++;
+    }
+    return runs / seconds;
+}
+
+/**
+ * Compare the number of ECAN cycles per second done by the separate AF
+ * and WA diffusion and rent agents, each in its own thread, with that of
+ * the EcanPipelineAgent, on a random graph with a full AF. Both use
+ * snapshot diffusion on the same number of threads.
+ */
+int main(int argc, char** argv)
+{
+    size_t num_nodes = 5000;
+    size_t degree = 3;
+    size_t af_size = 500;
+    double seconds = 5;
+    int threads = 1;
+
+    if (1 < argc) num_nodes = strtoul(argv[1], nullptr, 10);
+    if (2 < argc) degree = strtoul(argv[2], nullptr, 10);
+    if (3 < argc) af_size = strtoul(argv[3], nullptr, 10);
+    if (4 < argc) seconds = atof(argv[4]);
+    if (5 < argc) threads = atoi(argv[5]);
+
+    CogServer& cs = cogserver();
+    AtomSpace& as = cs.getAtomSpace();
+    SchemeEval eval(&as);
+    eval.eval("(use-modules (opencog) (opencog attention-bank))");
+
+    AttentionBank& bank(attentionbank(&as));
+    AttentionParamQuery atq(&as);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, num_nodes - 1);
+    std::uniform_real_distribution<double> strength(0.5, 1.0);
+
+    HandleSeq nodes;
+    for (size_t i = 0; i < num_nodes; i++)
+        nodes.push_back(as.add_node(CONCEPT_NODE, "pipe-" + std::to_string(i)));
+
+    for (size_t i = 0; i < num_nodes; i++) {
+        for (size_t d = 0; d < degree; d++) {
+            Handle other = nodes[pick(rng)];
+            if (other == nodes[i]) continue;
+            as.add_link(INHERITANCE_LINK, nodes[i], other);
+            Handle heb = as.add_link(ASYMMETRIC_HEBBIAN_LINK, nodes[i], nodes[pick(rng)]);
+            heb->setTruthValue(SimpleTruthValue::createTV(strength(rng), 0.9));
+        }
+    }
+
+    HandleSeq hot;
+    for (size_t i = 0; i < af_size; i++)
+        hot.push_back(nodes[pick(rng)]);
+
+    bank.set_af_size(af_size);
+
+    // Created before the parameters are set, as each agent reloads the
+    // defaults when it is constructed.
+    AFImportanceDiffusionAgent afDiffusion(cs);
+    WAImportanceDiffusionAgent waDiffusion(cs);
+    AFRentCollectionAgent afRent(cs);
+    WARentCollectionAgent waRent(cs);
+    EcanPipelineAgent pipeline(cs);
+
+    atq.set_param(AttentionParamQuery::dif_jacobi_threads, threads);
+
+    printf("%zu atoms, AF of %zu, %d diffusion threads, %g s per mode\n",
+           as.get_size(), af_size, threads, seconds);
+    printf("%-10s %14s\n", "mode", "cycles/s");
+
+    stimulate(bank, hot);
+    double agents = run_agents({&afDiffusion, &waDiffusion, &afRent, &waRent},
+                               seconds);
+    printf("%-10s %14.1f\n", "agents", agents);
+
+    stimulate(bank, hot);
+    double piped = run_pipeline(pipeline, seconds);
+    printf("%-10s %14.1f\n", "pipeline", piped);
+
+    return 0;
+}
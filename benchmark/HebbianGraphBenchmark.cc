@@ -0,0 +1,145 @@
+/*
+ * benchmark/HebbianGraphBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include <opencog/attention/HebbianGraph.h>
+#include <opencog/attention/Neighbors.h>
+
+using namespace opencog;
+
+typedef std::chrono::steady_clock bclock;
+
+/// Resident set size of this process, in bytes.
+static size_t resident(void)
+{
+#ifdef __GLIBC__
+    // Hand freed memory back to the system, so that it shows.
+    malloc_trim(0);
+#endif
+    size_t pages = 0, rss = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> rss;
+    return rss * sysconf(_SC_PAGESIZE);
+}
+
+static double seconds_since(bclock::time_point t)
+{
+    return std::chrono::duration<double>(bclock::now() - t).count();
+}
+
+/**
+ * Memory per edge and neighbour scan time of hebbian links kept as
+ * AtomSpace links and in a HebbianGraph. Each node gets a number of
+ * hebbian links to random other nodes, and also some inheritance links,
+ * so that the incoming sets hold more than hebbian links. The targets of
+ * every node are then listed, first with get_target_neighbors, and again
+ * after the HebbianGraph has taken the links over.
+ */
+int main(int argc, char** argv)
+{
+    size_t num_nodes = 100000;
+    size_t degree = 10;
+    int scans = 10;
+
+    if (1 < argc) num_nodes = strtoul(argv[1], nullptr, 10);
+    if (2 < argc) degree = strtoul(argv[2], nullptr, 10);
+    if (3 < argc) scans = atoi(argv[3]);
+
+    AtomSpace as;
+    attentionbank(&as);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, num_nodes - 1);
+    std::uniform_real_distribution<double> strength(0, 1);
+
+    HandleSeq nodes;
+    for (size_t i = 0; i < num_nodes; i++)
+        nodes.push_back(as.add_node(CONCEPT_NODE, "graph-" + std::to_string(i)));
+    for (size_t i = 0; i < num_nodes; i++)
+        for (size_t d = 0; d < degree; d++)
+            as.add_link(INHERITANCE_LINK, nodes[i], nodes[pick(rng)]);
+
+    size_t base = resident();
+    for (size_t i = 0; i < num_nodes; i++) {
+        for (size_t d = 0; d < degree; d++) {
+            Handle heb = as.add_link(ASYMMETRIC_HEBBIAN_LINK,
+                                     nodes[i], nodes[pick(rng)]);
+            heb->setTruthValue(SimpleTruthValue::createTV(strength(rng), 0.1));
+        }
+    }
+    size_t edges = as.get_num_atoms_of_type(ASYMMETRIC_HEBBIAN_LINK);
+    size_t with_links = resident();
+
+    size_t found = 0;
+    auto t0 = bclock::now();
+    for (int s = 0; s < scans; s++)
+        for (const Handle& h : nodes)
+            found += get_target_neighbors(h, ASYMMETRIC_HEBBIAN_LINK).size();
+    double link_scan = seconds_since(t0);
+
+    t0 = bclock::now();
+    HebbianGraph graph(&as);
+    graph.take_links();
+    double absorb = seconds_since(t0);
+    size_t with_graph = resident();
+
+    t0 = bclock::now();
+    for (int s = 0; s < scans; s++)
+        for (const Handle& h : nodes)
+            found -= graph.row(h).size();
+    double graph_scan = seconds_since(t0);
+
+    printf("%zu nodes, %zu hebbian edges, %d scans\n",
+           num_nodes, edges, scans);
+    printf("%-24s %14s %14s\n", "", "links", "graph");
+    printf("%-24s %14.1f %14.1f\n", "resident bytes/edge",
+           (with_links - base) / double(edges),
+           (with_graph - base) / double(edges));
+    printf("%-24s %14s %14.1f\n", "counted bytes/edge", "-",
+           graph.bytes() / double(edges));
+    printf("%-24s %14.1f %14.1f\n", "scan ns/neighbour",
+           link_scan * 1e9 / (scans * edges),
+           graph_scan * 1e9 / (scans * edges));
+    printf("took the links over in %.2f s\n", absorb);
+
+    // Both scans must have seen the same edges.
+    if (0 != found) {
+        fprintf(stderr, "neighbour counts differ by %zd\n", (ssize_t) found);
+        return 1;
+    }
+    return 0;
+}
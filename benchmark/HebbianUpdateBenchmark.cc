@@ -0,0 +1,108 @@
+/*
+ * benchmark/HebbianUpdateBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include <opencog/attention/AttentionParamQuery.h>
+#include <opencog/attention/HebbianUpdatingAgent.h>
+
+using namespace opencog;
+
+typedef std::chrono::steady_clock bclock;
+
+/**
+ * Throughput of the HebbianUpdatingAgent on a fully linked attentional
+ * focus, with the weights kept as links and in the dense AF matrix. Every
+ * run updates every link between the AF atoms, so the number of links
+ * updated per run is n * (n - 1).
+ */
+int main(int argc, char** argv)
+{
+    size_t af_size = 300;
+    int cycles = 10;
+
+    if (1 < argc) af_size = strtoul(argv[1], nullptr, 10);
+    if (2 < argc) cycles = atoi(argv[2]);
+
+    CogServer& cs = cogserver();
+    AtomSpace& as = cs.getAtomSpace();
+    SchemeEval eval(&as);
+    eval.eval("(use-modules (opencog) (opencog attention-bank))");
+
+    AttentionBank& bank(attentionbank(&as));
+    AttentionParamQuery atq(&as);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> sti(0, 1000);
+    std::uniform_real_distribution<double> strength(0, 1);
+
+    HandleSeq nodes;
+    for (size_t i = 0; i < af_size; i++)
+        nodes.push_back(as.add_node(CONCEPT_NODE, "heb-" + std::to_string(i)));
+
+    for (const Handle& a : nodes) {
+        for (const Handle& b : nodes) {
+            if (a == b) continue;
+            Handle heb = as.add_link(ASYMMETRIC_HEBBIAN_LINK, a, b);
+            heb->setTruthValue(SimpleTruthValue::createTV(strength(rng), 0.1));
+        }
+    }
+
+    bank.set_af_size(af_size);
+    for (const Handle& h : nodes)
+        bank.set_sti(h, sti(rng));
+
+    double links = double(af_size) * (af_size - 1) * cycles;
+
+    printf("%zu AF atoms, %.0f links, %d cycles\n",
+           af_size, links / cycles, cycles);
+    printf("%-10s %12s %16s\n", "store", "ms", "links/s");
+
+    HebbianUpdatingAgent agent(cs);
+    for (int dense : {0, 1}) {
+        atq.set_param(AttentionParamQuery::heb_dense_store, dense);
+
+        // The first run switches the store, and loads the matrix.
+        agent.run();
+
+        auto start = bclock::now();
+        for (int c = 0; c < cycles; c++)
+            agent.run();
+        double millis = std::chrono::duration<double, std::milli>(
+                bclock::now() - start).count();
+
+        printf("%-10s %12.1f %16.0f\n", dense ? "dense" : "atomspace",
+               millis, links / millis * 1000);
+    }
+
+    return 0;
+}
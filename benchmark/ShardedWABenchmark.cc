@@ -0,0 +1,113 @@
+/*
+ * benchmark/ShardedWABenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include <opencog/attention/AttentionParamQuery.h>
+#include <opencog/attention/ShardedWAAgent.h>
+
+using namespace opencog;
+
+typedef std::chrono::steady_clock bclock;
+
+/**
+ * Throughput of the ShardedWAAgent, in sampled atoms per second, for a
+ * growing number of shards, on a random graph in which every node has
+ * some STI. Every run diffuses and settles the rent of one batch.
+ */
+int main(int argc, char** argv)
+{
+    size_t num_nodes = 100000;
+    size_t degree = 4;
+    unsigned int batch = 10000;
+    int cycles = 20;
+
+    if (1 < argc) num_nodes = strtoul(argv[1], nullptr, 10);
+    if (2 < argc) degree = strtoul(argv[2], nullptr, 10);
+    if (3 < argc) batch = strtoul(argv[3], nullptr, 10);
+    if (4 < argc) cycles = atoi(argv[4]);
+
+    CogServer& cs = cogserver();
+    AtomSpace& as = cs.getAtomSpace();
+    SchemeEval eval(&as);
+    eval.eval("(use-modules (opencog) (opencog attention-bank))");
+
+    AttentionBank& bank(attentionbank(&as));
+    AttentionParamQuery atq(&as);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, num_nodes - 1);
+    std::uniform_real_distribution<double> strength(0.5, 1.0);
+    std::uniform_real_distribution<double> sti(10, 100);
+
+    HandleSeq nodes;
+    for (size_t i = 0; i < num_nodes; i++)
+        nodes.push_back(as.add_node(CONCEPT_NODE, "shard-" + std::to_string(i)));
+
+    for (size_t i = 0; i < num_nodes; i++) {
+        for (size_t d = 0; d < degree; d++) {
+            Handle other = nodes[pick(rng)];
+            if (other == nodes[i]) continue;
+            as.add_link(INHERITANCE_LINK, nodes[i], other);
+            Handle heb = as.add_link(ASYMMETRIC_HEBBIAN_LINK, nodes[i], nodes[pick(rng)]);
+            heb->setTruthValue(SimpleTruthValue::createTV(strength(rng), 0.9));
+        }
+    }
+
+    bank.set_af_size(100);
+
+    ShardedWAAgent agent(cs);
+    atq.set_param(AttentionParamQuery::dif_wa_batch_size, batch);
+
+    printf("%zu atoms, batch of %u, %d cycles\n", as.get_size(), batch, cycles);
+    printf("%-8s %14s %10s\n", "shards", "atoms/s", "speedup");
+
+    double base = 0;
+    for (unsigned int shards : {1, 2, 4, 8}) {
+        atq.set_param(AttentionParamQuery::dif_wa_shards, shards);
+
+        std::mt19937 stim(7);
+        for (const Handle& h : nodes)
+            bank.set_sti(h, sti(stim));
+
+        auto start = bclock::now();
+        for (int c = 0; c < cycles; c++)
+            agent.run();
+        double secs = std::chrono::duration<double>(bclock::now() - start).count();
+
+        double rate = batch * cycles / secs;
+        if (0 == base) base = rate;
+        printf("%-8u %14.0f %10.2f\n", shards, rate, rate / base);
+    }
+
+    return 0;
+}
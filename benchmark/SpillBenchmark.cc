@@ -0,0 +1,143 @@
+/*
+ * benchmark/SpillBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/bank/AtomSpillStore.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+
+using namespace opencog;
+
+typedef std::chrono::steady_clock bclock;
+
+/// Resident set size of this process, in bytes.
+static size_t resident(void)
+{
+#ifdef __GLIBC__
+    // Hand freed memory back to the system, so that it shows.
+    malloc_trim(0);
+#endif
+    size_t pages = 0, rss = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> rss;
+    return rss * sysconf(_SC_PAGESIZE);
+}
+
+static double seconds_since(bclock::time_point t)
+{
+    return std::chrono::duration<double>(bclock::now() - t).count();
+}
+
+/**
+ * Spill throughput, reload throughput and resident memory saved by the
+ * AtomSpillStore. A number of nodes, each linked to the next by a
+ * hebbian link, are given AVs and TVs. They are spilled and removed, as
+ * the ForgettingAgent would, and then referenced again, which reloads
+ * them. The reloaded values are checked against the originals.
+ */
+int main(int argc, char** argv)
+{
+    size_t num_atoms = 200000;
+    std::string path = "spill-benchmark.seg";
+
+    if (1 < argc) num_atoms = strtoul(argv[1], nullptr, 10);
+    if (2 < argc) path = argv[2];
+
+    AtomSpace as;
+    AttentionBank& bank(attentionbank(&as));
+    AtomSpillStore store(&as, &bank, path);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> sti_dist(0, 1000);
+    std::uniform_real_distribution<double> tv_dist(0, 1);
+
+    size_t base = resident();
+
+    printf("Populating %zu nodes and links ...\n", num_atoms);
+    HandleSeq nodes, atoms;
+    for (size_t i = 0; i < num_atoms; i++) {
+        Handle h = as.add_node(CONCEPT_NODE, "spill-" + std::to_string(i));
+        bank.set_sti(h, sti_dist(rng));
+        bank.set_lti(h, sti_dist(rng));
+        h->setTruthValue(SimpleTruthValue::createTV(tv_dist(rng), 0.9));
+        nodes.push_back(h);
+        atoms.push_back(h);
+    }
+    for (size_t i = 0; i + 1 < num_atoms; i++) {
+        Handle l = as.add_link(ASYMMETRIC_HEBBIAN_LINK, nodes[i], nodes[i+1]);
+        l->setTruthValue(SimpleTruthValue::createTV(tv_dist(rng), 0.9));
+        atoms.push_back(l);
+    }
+
+    std::vector<AttentionValue::sti_t> sti(num_atoms);
+    for (size_t i = 0; i < num_atoms; i++)
+        sti[i] = get_sti(nodes[i]);
+
+    size_t total = atoms.size();
+    size_t loaded = resident();
+
+    // Spill and remove, in the order the ForgettingAgent does it.
+    auto t0 = bclock::now();
+    store.spill(atoms);
+    double spill_time = seconds_since(t0);
+
+    for (const Handle& h : nodes)
+        as.remove_atom(h, true);
+    bank.remove_atoms_from_bank(atoms);
+    atoms.clear();
+    nodes.clear();
+
+    size_t spilled = resident();
+
+    // Reference the nodes again, by name; their values come back.
+    t0 = bclock::now();
+    size_t wrong = 0;
+    for (size_t i = 0; i < num_atoms; i++) {
+        Handle h = as.add_node(CONCEPT_NODE, "spill-" + std::to_string(i));
+        if (get_sti(h) != sti[i]) wrong++;
+    }
+    double reload_time = seconds_since(t0);
+
+    printf("%zu atoms, %.1f MB on disk\n", total, store.bytes() / 1e6);
+    printf("spill      %12.0f atoms/s %10.1f MB/s\n",
+           total / spill_time, store.bytes() / 1e6 / spill_time);
+    printf("reload     %12.0f atoms/s  (%zu wrong)\n",
+           num_atoms / reload_time, wrong);
+    printf("resident   %10.1f MB loaded, %10.1f MB spilled, %.1f MB saved\n",
+           (loaded - base) / 1e6, (spilled - base) / 1e6,
+           ((double) loaded - (double) spilled) / 1e6);
+    printf("index      %zu links still spilled\n", store.size());
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * benchmark/WalkConvergenceBenchmark.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include <opencog/attention/AFImportanceDiffusionAgent.h>
+#include <opencog/attention/AttentionParamQuery.h>
+#include <opencog/attention/RandomWalkImportanceDiffusionAgent.h>
+
+using namespace opencog;
+
+typedef std::chrono::steady_clock bclock;
+
+/**
+ * Runs the given agent for a number of cycles, starting from the given
+ * STI values, and returns the STI values it ends with together with the
+ * time it took.
+ */
+static std::vector<double> run_agent(Agent& agent, AttentionBank& bank,
+                                     const HandleSeq& atoms,
+                                     const std::vector<double>& initial,
+                                     int cycles, double& millis)
+{
+    for (size_t i = 0; i < atoms.size(); i++)
+        bank.set_sti(atoms[i], initial[i]);
+
+    auto start = bclock::now();
+    for (int c = 0; c < cycles; c++)
+        agent.run();
+    millis = std::chrono::duration<double, std::milli>(
+            bclock::now() - start).count();
+
+    std::vector<double> result(atoms.size());
+    for (size_t i = 0; i < atoms.size(); i++)
+        result[i] = get_sti(atoms[i]);
+    return result;
+}
+
+/**
+ * Compare the RandomWalkImportanceDiffusionAgent against the exact
+ * AFImportanceDiffusionAgent on a random graph. A few nodes are
+ * stimulated, both agents run for the same number of cycles from the
+ * same start, and the relative L1 distance between the resulting STI
+ * vectors is reported for a range of walk quanta. The error should
+ * shrink roughly with the square root of the quantum.
+ */
+int main(int argc, char** argv)
+{
+    size_t num_nodes = 2000;
+    size_t degree = 3;
+    int cycles = 10;
+    int threads = 0;
+
+    if (1 < argc) num_nodes = strtoul(argv[1], nullptr, 10);
+    if (2 < argc) degree = strtoul(argv[2], nullptr, 10);
+    if (3 < argc) cycles = atoi(argv[3]);
+    if (4 < argc) threads = atoi(argv[4]);
+
+    CogServer& cs = cogserver();
+    AtomSpace& as = cs.getAtomSpace();
+    SchemeEval eval(&as);
+    eval.eval("(use-modules (opencog) (opencog attention-bank))");
+
+    AttentionBank& bank(attentionbank(&as));
+    AttentionParamQuery atq(&as);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, num_nodes - 1);
+    std::uniform_real_distribution<double> strength(0.5, 1.0);
+
+    HandleSeq nodes;
+    for (size_t i = 0; i < num_nodes; i++)
+        nodes.push_back(as.add_node(CONCEPT_NODE, "walk-" + std::to_string(i)));
+
+    for (size_t i = 0; i < num_nodes; i++) {
+        for (size_t d = 0; d < degree; d++) {
+            Handle other = nodes[pick(rng)];
+            if (other == nodes[i]) continue;
+            as.add_link(INHERITANCE_LINK, nodes[i], other);
+            Handle heb = as.add_link(ASYMMETRIC_HEBBIAN_LINK, nodes[i], nodes[pick(rng)]);
+            heb->setTruthValue(SimpleTruthValue::createTV(strength(rng), 0.9));
+        }
+    }
+
+    HandleSeq atoms;
+    as.get_handles_by_type(atoms, ATOM, true);
+
+    // Every atom fits in the AF, so that its membership cannot differ
+    // between runs; atoms with no STI diffuse nothing.
+    bank.set_af_size(atoms.size());
+
+    std::vector<double> initial(atoms.size(), 0);
+    for (int s = 0; s < 10; s++) {
+        Handle h = nodes[pick(rng)];
+        auto it = std::find(atoms.begin(), atoms.end(), h);
+        initial[it - atoms.begin()] = 1000;
+    }
+
+    atq.set_param(AttentionParamQuery::dif_jacobi_threads, threads);
+
+    AFImportanceDiffusionAgent exact(cs);
+    double exact_ms;
+    std::vector<double> expected =
+        run_agent(exact, bank, atoms, initial, cycles, exact_ms);
+
+    double norm = 0;
+    for (double v : expected) norm += std::fabs(v);
+
+    printf("%zu atoms, %d cycles\n", atoms.size(), cycles);
+    printf("%-10s %12s %14s\n", "quantum", "ms", "rel L1 error");
+    printf("%-10s %12.1f %14s\n", "exact", exact_ms, "-");
+
+    RandomWalkImportanceDiffusionAgent walk(cs);
+    for (double quantum : {10.0, 3.0, 1.0, 0.3, 0.1}) {
+        atq.set_param(AttentionParamQuery::dif_walk_quantum, quantum);
+
+        double walk_ms;
+        std::vector<double> got =
+            run_agent(walk, bank, atoms, initial, cycles, walk_ms);
+
+        double error = 0;
+        for (size_t i = 0; i < atoms.size(); i++)
+            error += std::fabs(got[i] - expected[i]);
+
+        printf("%-10g %12.1f %14.6f\n", quantum, walk_ms, error / norm);
+    }
+
+    return 0;
+}
@@ -0,0 +1,374 @@
+/*
+ * opencog/attention/AFHebbianMatrix.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include "AFHebbianMatrix.h"
+
+using namespace opencog;
+using namespace std::placeholders;
+
+static const float NO_LINK = std::numeric_limits<float>::quiet_NaN();
+
+AFHebbianMatrix::AFHebbianMatrix(AtomSpace* as, const HebbianStorePtr& links) :
+    _as(as), _bank(&attentionbank(as)), _links(links), _capacity(0),
+    _persistThreshold(1.0)
+{
+    // Size the matrix before the handlers can see it, so that an atom
+    // entering the AF meanwhile always finds a free slot.
+    std::unique_lock<std::mutex> lock(_mtx);
+    grow(std::max<size_t>(1, (size_t) _bank->get_af_size()));
+    _addAFConnection = _bank->AddAFSignal().connect(
+            std::bind(&AFHebbianMatrix::addAFHandler, this, _1, _2, _3));
+    _removeAFConnection = _bank->RemoveAFSignal().connect(
+            std::bind(&AFHebbianMatrix::removeAFHandler, this, _1, _2, _3));
+    _removeConnection = _as->atomRemovedSignal().connect(
+            std::bind(&AFHebbianMatrix::atomRemovedHandler, this, _1));
+    lock.unlock();
+
+    // The bank emits its AF signals under its own lock, so it is not
+    // asked for the AF while _mtx is held. Atoms the handlers have
+    // already placed are skipped by assign().
+    HandleSeq af;
+    _bank->get_handle_set_in_attentional_focus(std::back_inserter(af));
+
+    lock.lock();
+    for (const Handle& h : af)
+        assign(h);
+}
+
+AFHebbianMatrix::~AFHebbianMatrix()
+{
+    _bank->AddAFSignal().disconnect(_addAFConnection);
+    _bank->RemoveAFSignal().disconnect(_removeAFConnection);
+    _as->atomRemovedSignal().disconnect(_removeConnection);
+
+    std::vector<Edge> entries;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        entries.swap(_pending);
+        for (size_t i = 0; i < _capacity; i++) {
+            if (Handle::UNDEFINED == _atoms[i]) continue;
+            for (size_t j = 0; j < _capacity; j++) {
+                size_t k = i * _capacity + j;
+                if (std::isnan(_strength[k])) continue;
+                entries.push_back({_atoms[i], _atoms[j],
+                                   _strength[k], _confidence[k]});
+            }
+        }
+    }
+    _links->put(entries);
+}
+
+/*
+ * grow, assign and release expect the caller to hold _mtx.
+ */
+void AFHebbianMatrix::grow(size_t capacity)
+{
+    std::vector<float> strength(capacity * capacity, NO_LINK);
+    std::vector<float> confidence(capacity * capacity, NO_LINK);
+    for (size_t i = 0; i < _capacity; i++) {
+        std::copy_n(&_strength[i * _capacity], _capacity,
+                    &strength[i * capacity]);
+        std::copy_n(&_confidence[i * _capacity], _capacity,
+                    &confidence[i * capacity]);
+    }
+    _strength.swap(strength);
+    _confidence.swap(confidence);
+
+    // Hand out the lowest slots first.
+    _atoms.resize(capacity);
+    for (size_t s = capacity; s > _capacity; s--)
+        _free.push_back(s - 1);
+    _capacity = capacity;
+}
+
+void AFHebbianMatrix::assign(const Handle& h)
+{
+    if (nameserver().isA(h->get_type(), HEBBIAN_LINK)) return;
+    if (_slots.count(h)) return;
+
+    if (_free.empty()) grow(std::max<size_t>(1, 2 * _capacity));
+    size_t s = _free.back();
+    _free.pop_back();
+    _slots[h] = s;
+    _atoms[s] = h;
+
+    // The row and column are empty, release() leaves them so. Fill them
+    // from the links to and from other AF atoms, and then from the weights still
+    // waiting to be written back, which are newer.
+    auto load = [&](const Handle& from, const Handle& to,
+                    float strength, float confidence)
+    {
+        auto fi = _slots.find(from);
+        auto ti = _slots.find(to);
+        if (fi == _slots.end() or ti == _slots.end()) return;
+        size_t k = fi->second * _capacity + ti->second;
+        _strength[k] = strength;
+        _confidence[k] = confidence;
+    };
+
+    for (const Weight& w : _links->row(h))
+        load(h, w.target, w.strength, w.confidence);
+    for (const Weight& w : _links->column(h))
+        load(w.target, h, w.strength, w.confidence);
+    for (const Edge& e : _pending)
+        if (e.source == h or e.target == h)
+            load(e.source, e.target, e.strength, e.confidence);
+}
+
+void AFHebbianMatrix::release(const Handle& h, bool writeBack)
+{
+    auto it = _slots.find(h);
+    if (it == _slots.end()) return;
+    size_t s = it->second;
+
+    for (size_t j = 0; j < _capacity; j++) {
+        size_t out = s * _capacity + j;
+        size_t in = j * _capacity + s;
+        if (writeBack and not std::isnan(_strength[out]))
+            _pending.push_back({h, _atoms[j], _strength[out], _confidence[out]});
+        if (writeBack and j != s and not std::isnan(_strength[in]))
+            _pending.push_back({_atoms[j], h, _strength[in], _confidence[in]});
+        _strength[out] = _strength[in] = NO_LINK;
+        _confidence[out] = _confidence[in] = NO_LINK;
+    }
+
+    _atoms[s] = Handle::UNDEFINED;
+    _slots.erase(it);
+    _free.push_back(s);
+}
+
+/*
+ * The AF signals are emitted under the bank's AF lock, so these handlers
+ * must not call back into the bank or add atoms.
+ */
+void AFHebbianMatrix::addAFHandler(const Handle& h, const AttentionValuePtr&,
+                                   const AttentionValuePtr&)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    assign(h);
+}
+
+void AFHebbianMatrix::removeAFHandler(const Handle& h, const AttentionValuePtr&,
+                                      const AttentionValuePtr&)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    release(h, true);
+}
+
+void AFHebbianMatrix::atomRemovedHandler(const AtomPtr& atom)
+{
+    Handle h(atom);
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (0 == _slots.count(h)) return;
+    release(h, false);
+    changed();
+}
+
+void AFHebbianMatrix::add(const std::set<std::pair<Handle, Handle>>& pairs,
+                          strength_t strength, confidence_t confidence)
+{
+    std::set<std::pair<Handle, Handle>> rest;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        for (const auto& p : pairs) {
+            auto fi = _slots.find(p.first);
+            auto ti = _slots.find(p.second);
+            if (fi == _slots.end() or ti == _slots.end()) {
+                rest.insert(p);
+                continue;
+            }
+            size_t k = fi->second * _capacity + ti->second;
+            if (not std::isnan(_strength[k])) continue;
+            _strength[k] = strength;
+            _confidence[k] = confidence;
+            changed();
+        }
+    }
+    _links->add(rest, strength, confidence);
+}
+
+/*
+ * The links to atoms outside the AF come from the AtomSpace, those to AF
+ * atoms from the matrix row, as their links may be out of date.
+ */
+HebbianStore::Row AFHebbianMatrix::row(const Handle& source)
+{
+    flush();
+    Row result = _links->row(source);
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto si = _slots.find(source);
+    if (si == _slots.end()) return result;
+
+    result.erase(std::remove_if(result.begin(), result.end(),
+                 [&](const Weight& w) { return _slots.count(w.target); }),
+                 result.end());
+
+    const float* strength = &_strength[si->second * _capacity];
+    const float* confidence = &_confidence[si->second * _capacity];
+    for (size_t j = 0; j < _capacity; j++)
+        if (not std::isnan(strength[j]))
+            result.push_back({_atoms[j], strength[j], confidence[j]});
+    return result;
+}
+
+void AFHebbianMatrix::set_row(const Handle& source, const Row& row)
+{
+    set_rows({{source, row}});
+}
+
+/*
+ * All the rows are written under one lock. The weights that reach the
+ * persist threshold, and those to atoms outside the AF, are written to
+ * the AtomSpace afterwards.
+ */
+void AFHebbianMatrix::set_rows(const Rows& rows)
+{
+    Rows rest;
+    std::vector<Edge> persist;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        for (const auto& r : rows) {
+            const Handle& source = r.first;
+            Row outside;
+            auto si = _slots.find(source);
+            for (const Weight& w : r.second) {
+                auto ti = _slots.find(w.target);
+                if (si == _slots.end() or ti == _slots.end()) {
+                    outside.push_back(w);
+                    continue;
+                }
+                size_t k = si->second * _capacity + ti->second;
+                if (std::isnan(_strength[k])) continue;
+                if (_strength[k] < _persistThreshold and
+                    _persistThreshold <= w.strength)
+                    persist.push_back({source, w.target,
+                                       w.strength, w.confidence});
+                _strength[k] = w.strength;
+                _confidence[k] = w.confidence;
+                changed();
+            }
+            if (not outside.empty())
+                rest.emplace_back(source, std::move(outside));
+        }
+    }
+    _links->put(persist);
+    _links->set_rows(rest);
+}
+
+void AFHebbianMatrix::put(const std::vector<Edge>& edges)
+{
+    std::vector<Edge> rest;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        for (const Edge& e : edges) {
+            auto fi = _slots.find(e.source);
+            auto ti = _slots.find(e.target);
+            if (fi == _slots.end() or ti == _slots.end()) {
+                rest.push_back(e);
+                continue;
+            }
+            size_t k = fi->second * _capacity + ti->second;
+            _strength[k] = e.strength;
+            _confidence[k] = e.confidence;
+            changed();
+        }
+    }
+    _links->put(rest);
+}
+
+HebbianStore::Row AFHebbianMatrix::column(const Handle& target)
+{
+    flush();
+    Row result = _links->column(target);
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto ti = _slots.find(target);
+    if (ti == _slots.end()) return result;
+
+    result.erase(std::remove_if(result.begin(), result.end(),
+                 [&](const Weight& w) { return _slots.count(w.target); }),
+                 result.end());
+
+    for (size_t i = 0; i < _capacity; i++) {
+        size_t k = i * _capacity + ti->second;
+        if (not std::isnan(_strength[k]))
+            result.push_back({_atoms[i], _strength[k], _confidence[k]});
+    }
+    return result;
+}
+
+HandleSeq AFHebbianMatrix::sources(const Handle& target)
+{
+    HandleSeq result;
+    for (const Weight& w : column(target))
+        result.push_back(w.target);
+    return result;
+}
+
+/*
+ * Only the links behind the matrix count; those between AF atoms are
+ * left alone until they are written back.
+ */
+void AFHebbianMatrix::limit_degree(const Handle& atom, size_t maxLinks)
+{
+    _links->limit_degree(atom, maxLinks);
+}
+
+void AFHebbianMatrix::flush()
+{
+    std::vector<Edge> entries;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        entries.swap(_pending);
+    }
+    _links->put(entries);
+}
+
+void AFHebbianMatrix::set_persist_threshold(strength_t threshold)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _persistThreshold = threshold;
+}
+
+/*
+ * The sum of the two counters, which goes up whenever either does.
+ */
+unsigned long AFHebbianMatrix::version() const
+{
+    return HebbianStore::version() + _links->version();
+}
+
+size_t AFHebbianMatrix::size()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _slots.size();
+}
@@ -0,0 +1,120 @@
+/*
+ * opencog/attention/AFHebbianMatrix.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_AF_HEBBIAN_MATRIX_H
+#define _OPENCOG_AF_HEBBIAN_MATRIX_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/attentionbank/avalue/AttentionValue.h>
+
+#include "HebbianStore.h"
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/**
+ * A hebbian store that keeps the weights between atoms in the attentional
+ * focus in two dense float matrices, instead of in AsymmetricHebbianLinks.
+ *
+ * Every atom gets a slot when it enters the AF, and frees it when it
+ * leaves. Row i holds the weights of the links out of the atom in slot i,
+ * so reading or updating all the links of an AF atom is a scan of one
+ * contiguous row. A NaN strength marks a pair that has no link. On
+ * entering the AF, an atom's row and column are loaded from the links it
+ * already has to and from other AF atoms.
+ *
+ * Weights are only written back when one of their atoms leaves the AF,
+ * or when set_row raises a strength to the persist threshold.
+ * Leaving the AF happens under the bank's AF lock, so the write back is
+ * queued there and done by the next call into the store, or by flush().
+ * Links that involve an atom outside the AF, and the written back
+ * weights, go to the store behind the matrix, which keeps them as
+ * AtomSpace links or in a HebbianGraph.
+ *
+ * The matrices start out as large as the AF, and double whenever the AF
+ * outgrows them.
+ */
+class AFHebbianMatrix : public HebbianStore
+{
+private:
+    AtomSpace* _as;
+    AttentionBank* _bank;
+    HebbianStorePtr _links;
+
+    std::mutex _mtx;
+    size_t _capacity;
+    std::vector<float> _strength;   // _capacity x _capacity, row major
+    std::vector<float> _confidence;
+    HandleSeq _atoms;               // Atom in each slot
+    std::unordered_map<Handle, size_t> _slots;
+    std::vector<size_t> _free;
+    std::vector<Edge> _pending;     // Weights waiting to be written back
+    strength_t _persistThreshold;
+
+    int _addAFConnection;
+    int _removeAFConnection;
+    int _removeConnection;
+
+    void grow(size_t);
+    void assign(const Handle&);
+    void release(const Handle&, bool writeBack);
+
+    void addAFHandler(const Handle&, const AttentionValuePtr&,
+                      const AttentionValuePtr&);
+    void removeAFHandler(const Handle&, const AttentionValuePtr&,
+                         const AttentionValuePtr&);
+    void atomRemovedHandler(const AtomPtr&);
+
+public:
+    AFHebbianMatrix(AtomSpace*, const HebbianStorePtr& links);
+
+    /// Writes all the weights in the matrices back.
+    ~AFHebbianMatrix();
+
+    void add(const std::set<std::pair<Handle, Handle>>&,
+             strength_t, confidence_t);
+    Row row(const Handle& source);
+    void set_row(const Handle& source, const Row&);
+    void set_rows(const Rows&);
+    void put(const std::vector<Edge>&);
+    Row column(const Handle& target);
+    HandleSeq sources(const Handle& target);
+    void limit_degree(const Handle&, size_t maxLinks);
+    void flush();
+    unsigned long version() const;
+
+    void set_persist_threshold(strength_t);
+
+    /// Number of atoms that hold a slot.
+    size_t size();
+};
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_AF_HEBBIAN_MATRIX_H
@@ -23,7 +23,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <thread>
 
 #include <opencog/cogserver/server/CogServer.h>
@@ -36,22 +38,69 @@
 
 using namespace opencog;
 
+// Sources diffused between two checks of the run budget.
+static const size_t DIFFUSION_CHUNK = 64;
+
+static bool sameWeights(const HebbianStore::Row& a, const HebbianStore::Row& b)
+{
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i].target != b[i].target or a[i].strength != b[i].strength or
+            a[i].confidence != b[i].confidence)
+            return false;
+    return true;
+}
+
 AFImportanceDiffusionAgent::AFImportanceDiffusionAgent(CogServer& cs) :
-    ImportanceDiffusionBase(cs)
+    ImportanceDiffusionBase(cs), _jacobiThreads(0), _epsilon(0),
+    _trackingDirty(false), _cacheVersion(0), _budget(info().id), _cursor(0)
+{
+}
+
+AFImportanceDiffusionAgent::~AFImportanceDiffusionAgent()
 {
+    if (_trackingDirty) _bank->set_dirty_tracking(false);
 }
 
 void AFImportanceDiffusionAgent::run()
 {
+    // Not yet due, if paced to hold AGENT_CPU_SHARE.
+    if (not _rates->begin(classinfo().id)) return;
+
+    double oldSpread = maxSpreadPercentage;
+    double oldHebbian = hebbianMaxAllocationPercentage;
+    bool oldHebbianOnly = spreadHebbianOnly;
+
     // Reread param values for dynamically updating the values.
-    maxSpreadPercentage = std::stod(_atq.get_param_value(
-                                    AttentionParamQuery::dif_spread_percentage));
-    hebbianMaxAllocationPercentage =std::stod(_atq.get_param_value(
-                                    AttentionParamQuery::heb_max_alloc_percentage));
-    spreadHebbianOnly = std::stoi(_atq.get_param_value(
-                                  AttentionParamQuery::dif_spread_hebonly));
+    EcanParamsPtr params = _atq.params();
+    maxSpreadPercentage = params->dif_spread_percentage;
+    hebbianMaxAllocationPercentage = params->heb_max_alloc_percentage;
+    spreadHebbianOnly = params->dif_spread_hebonly;
+    _jacobiThreads = params->dif_jacobi_threads;
+    _epsilon = params->dif_incremental_epsilon;
+    bool filterChanged = _spreadingFilter.refresh();
+    _hebbian = _stores->get(*params);
+
+    // An unfinished sweep was filtered under the old settings.
+    if (filterChanged) _sweep.clear();
 
+    // Anything cached was computed under the old settings.
+    if (filterChanged or oldSpread != maxSpreadPercentage or
+        oldHebbian != hebbianMaxAllocationPercentage or
+        oldHebbianOnly != spreadHebbianOnly)
+        _cache.clear();
+
+    if ((0 < _epsilon) != _trackingDirty) {
+        _trackingDirty = (0 < _epsilon);
+        _bank->set_dirty_tracking(_trackingDirty);
+        _cache.clear();
+    }
+
+    _budget.start(params->agent_run_budget);
     spreadImportance();
+    _budget.stop();
+
+    _rates->end(classinfo().id);
 }
 
 /*
@@ -60,15 +109,144 @@ void AFImportanceDiffusionAgent::run()
  */
 void AFImportanceDiffusionAgent::spreadImportance()
 {
-    HandleSeq diffusionSourceVector =  ImportanceDiffusionBase::diffusionSourceVector();
+    // Incremental diffusion only redoes what changed, and needs to see
+    // all sources to keep its cache, so it is not split up.
+    if (0 < _epsilon) {
+        spreadIncremental(diffusionSourceVector());
+        return;
+    }
+
+    // Start a new sweep over the AF once the last one is done.
+    if (_cursor >= _sweep.size()) {
+        _sweep = diffusionSourceVector();
+        _cursor = 0;
+    }
+
+    // Without a budget, the whole sweep is one chunk.
+    size_t chunkSize = _budget.unlimited() ? _sweep.size() : DIFFUSION_CHUNK;
+
+    while (_cursor < _sweep.size())
+    {
+        size_t end = std::min(_sweep.size(), _cursor + chunkSize);
+
+        // Skip atoms removed since the sweep started.
+        HandleSeq chunk;
+        for (size_t i = _cursor; i < end; i++)
+            if (nullptr != _sweep[i]->getAtomSpace())
+                chunk.push_back(_sweep[i]);
+        _cursor = end;
+
+        if (0 < _jacobiThreads) {
+            diffuseSnapshot(chunk, _jacobiThreads);
+        } else {
+            // Calculate the diffusion for each source atom, and store the
+            // diffusion event in a stack
+            for (const Handle& atomSource : chunk) diffuseAtom(atomSource);
+
+            // Now, process all of the outstanding diffusion events in the
+            // diffusion stack
+            processDiffusionStack();
+        }
+
+        if (_budget.exhausted()) break;
+    }
+
+    if (_cursor < _sweep.size()) _budget.defer();
+}
+
+/*
+ * Diffuses from every source, recomputing only what has changed
+ *
+ * Sources whose neighbourhood changed, or that are new to the AF, get a
+ * fresh probability vector. Sources whose STI moved by more than the
+ * relative epsilon get a fresh diffusion amount. All other sources
+ * diffuse exactly as they did in the previous cycle. As in snapshot
+ * diffusion, the transfers are summed per atom and committed at once.
+ */
+void AFImportanceDiffusionAgent::spreadIncremental(const HandleSeq& sources)
+{
+    UnorderedHandleSet dirtyAV, dirtyNeighbourhood;
+    _bank->take_dirty(dirtyAV, dirtyNeighbourhood);
+
+    // Weights kept outside the AtomSpace change without the bank seeing
+    // it. Once the store has been written to, each cached row is checked
+    // against the store; a different store invalidates everything.
+    if (_cacheStore.lock() != _hebbian) _cache.clear();
+    unsigned long version = _hebbian->version();
+    bool weightsChanged = (version != _cacheVersion);
+    _cacheStore = _hebbian;
+    _cacheVersion = version;
+
+    // Sources that left the AF are dropped from the cache.
+    std::unordered_map<Handle, CachedSource> cache;
 
-    // Calculate the diffusion for each source atom, and store the diffusion
-    // event in a stack
-    for (Handle atomSource : diffusionSourceVector) diffuseAtom(atomSource);
+    HandleSeq atoms;
+    std::vector<AttentionValue::sti_t> deltas;
+    std::unordered_map<Handle, size_t> slot;
+    auto add = [&](const Handle& h, AttentionValue::sti_t amount)
+    {
+        auto res = slot.emplace(h, atoms.size());
+        if (res.second) {
+            atoms.push_back(h);
+            deltas.push_back(0);
+        }
+        deltas[res.first->second] += amount;
+    };
 
-    // Now, process all of the outstanding diffusion events in the diffusion
-    // stack
-    processDiffusionStack();
+    for (const Handle& source : sources)
+    {
+        auto it = _cache.find(source);
+        bool fresh = (it == _cache.end() or dirtyNeighbourhood.count(source));
+
+        HebbianStore::Row weights;
+        bool haveWeights = false;
+        if (not fresh and weightsChanged) {
+            weights = sortedWeights(source);
+            haveWeights = true;
+            fresh = not sameWeights(weights, it->second.weights);
+        }
+
+        CachedSource& c = cache[source];
+        if (fresh) {
+            c.weights = haveWeights ? std::move(weights)
+                                    : sortedWeights(source);
+            c.probabilityVector = diffusionVector(source);
+            c.sti = get_sti(source);
+            c.amount = calculateDiffusionAmount(source);
+        } else {
+            c = std::move(it->second);
+            if (dirtyAV.count(source)) {
+                AttentionValue::sti_t sti = get_sti(source);
+                if (std::fabs(sti - c.sti) > _epsilon * std::fabs(c.sti)) {
+                    c.sti = sti;
+                    c.amount = calculateDiffusionAmount(source);
+                }
+            }
+        }
+
+        if (c.amount == 0) continue;
+        for (const auto& p : c.probabilityVector) {
+            AttentionValue::sti_t amount = c.amount * p.second;
+            add(source, -amount);
+            add(p.first, amount);
+        }
+    }
+
+    _cache.swap(cache);
+    _bank->add_sti(atoms, deltas);
+}
+
+/*
+ * The hebbian row of the source, in a fixed order, so that two reads of
+ * the same weights compare equal.
+ */
+HebbianStore::Row AFImportanceDiffusionAgent::sortedWeights(const Handle& source)
+{
+    HebbianStore::Row row = _hebbian->row(source);
+    std::sort(row.begin(), row.end(),
+              [](const HebbianStore::Weight& a, const HebbianStore::Weight& b)
+              { return a.target < b.target; });
+    return row;
 }
 
 /*
@@ -26,6 +26,10 @@
 #ifndef AFIMPORTANCEDIFFUSIONAGENT_H
 #define AFIMPORTANCEDIFFUSIONAGENT_H
 
+#include <memory>
+#include <unordered_map>
+
+#include "AgentBudget.h"
 #include "ImportanceDiffusionBase.h"
 
 
@@ -49,6 +53,20 @@ namespace opencog
  * (2) Diffusion to atoms that are adjacent to each atom, where the type of
  *     the connecting edge is a hebbian link
  *
+ * When DIFFUSION_INCREMENTAL_EPSILON is positive, the agent works
+ * incrementally. It keeps each source's probability vector and diffusion
+ * amount from earlier cycles. A probability vector is recomputed only
+ * when the bank reports that the source's neighbourhood changed, or when
+ * the hebbian store has been written to and the source's row of weights
+ * is no longer the one the vector was computed from. A
+ * diffusion amount is recomputed only when the source's STI has moved by
+ * more than that fraction since the amount was last computed. All
+ * transfers of a cycle are committed in a single bank update.
+ *
+ * Otherwise, when AGENT_RUN_BUDGET is set, a run diffuses the AF in
+ * chunks until the budget is spent, and the next run carries on with the
+ * rest of the same sweep before taking a new copy of the AF.
+ *
  * Please refer to the detailed description of this agent in the README file,
  * where an extensive explanation of the algorithm, features and pending
  * work is explained.
@@ -59,11 +77,42 @@ class AFImportanceDiffusionAgent : public virtual ImportanceDiffusionBase
 private:
     friend class ::ImportanceDiffusionUTest;
 
+    // Number of threads for snapshot (Jacobi) diffusion; zero selects
+    // the sequential, live-STI diffusion.
+    unsigned int _jacobiThreads;
+
+    struct CachedSource {
+        AttentionValue::sti_t sti;    // STI the amount was computed from
+        AttentionValue::sti_t amount;
+        std::map<Handle, double> probabilityVector;
+        HebbianStore::Row weights;    // Row the vector was computed from
+    };
+
+    // Relative STI change that invalidates a cached amount; zero
+    // disables incremental diffusion.
+    double _epsilon;
+    bool _trackingDirty;
+    std::unordered_map<Handle, CachedSource> _cache;
+
+    // The hebbian store the cache was filled from, and its version then.
+    std::weak_ptr<HebbianStore> _cacheStore;
+    unsigned long _cacheVersion;
+
+    HebbianStore::Row sortedWeights(const Handle&);
+
+    // The sources of the current sweep over the AF, and how far it got.
+    AgentBudget _budget;
+    HandleSeq _sweep;
+    size_t _cursor;
+
+    void spreadIncremental(const HandleSeq&);
+
     void spreadImportance();
     AttentionValue::sti_t calculateDiffusionAmount(Handle);
 
 public:
      AFImportanceDiffusionAgent(CogServer&);
+    ~AFImportanceDiffusionAgent();
 
     virtual void run();
     virtual const ClassInfo& classinfo() const { return info(); }
@@ -43,7 +43,8 @@
 
 using namespace opencog;
 
-AFRentCollectionAgent::AFRentCollectionAgent(CogServer& cs) : RentCollectionBaseAgent(cs)
+AFRentCollectionAgent::AFRentCollectionAgent(CogServer& cs) :
+    RentCollectionBaseAgent(cs), started(false), update_freq(0)
 {
 }
 
@@ -58,13 +59,13 @@ void AFRentCollectionAgent::selectTargets(HandleSeq &targetSetOut)
 
 void AFRentCollectionAgent::collectRent(HandleSeq& targetSet)
 {
-    static bool first_time = true;
-    if (first_time) {
+    // Each instance keeps its own clock, from its first collection on.
+    if (not started) {
         last_update = high_resolution_clock::now();
-        first_time = false;
+        started = true;
     }
 
-    update_freq = std::stod(_atq.get_param_value(AttentionParamQuery::af_rent_update_freq));
+    update_freq = _atq.params()->af_rent_update_freq;
 
     // calculate elapsed time Et
     microseconds elapsed_time = duration_cast<microseconds>
@@ -75,26 +76,39 @@ void AFRentCollectionAgent::collectRent(HandleSeq& targetSet)
 
     double w = elapsed_time.count() * update_freq / 1000000;
 
-    for (const Handle& h : targetSet) {
-        AttentionValue::sti_t sti = get_sti(h);
-        AttentionValue::lti_t lti = get_lti(h);
-        AttentionValue::sti_t stiRent =  calculate_STI_Rent();
-        stiRent *= w;
-        AttentionValue::lti_t ltiRent =  calculate_LTI_Rent();
-        ltiRent *= w;
+    // Rent depends only on the funds and the parameters, so it is the
+    // same for every atom in this sweep.
+    AttentionValue::sti_t stiRent = calculate_STI_Rent() * w;
+    AttentionValue::lti_t ltiRent = calculate_LTI_Rent() * w;
+
+    size_t n = targetSet.size();
+    std::vector<AttentionValue::sti_t> sti(n);
+    std::vector<AttentionValue::lti_t> lti(n);
+    std::vector<AttentionValue::vlti_t> vlti(n);
+    for (size_t i = 0; i < n; i++) {
+        AttentionValuePtr av = get_av(targetSet[i]);
+        sti[i] = av->getSTI();
+        lti[i] = av->getLTI();
+        vlti[i] = av->getVLTI();
+    }
 
-        if (stiRent > sti) stiRent = sti;
-        if (ltiRent > lti) ltiRent = lti;
+    // Never take more than an atom has.
+    for (size_t i = 0; i < n; i++) {
+        sti[i] -= std::min(stiRent, sti[i]);
+        lti[i] -= std::min(ltiRent, lti[i]);
+    }
 
-        _bank->set_sti(h, sti - stiRent);
-        _bank->set_lti(h, lti - ltiRent);
+    std::vector<AttentionValuePtr> avs(n);
+    for (size_t i = 0; i < n; i++) {
+        avs[i] = AttentionValue::createAV(sti[i], lti[i], vlti[i]);
 
 #ifdef LOG_AV_STAT
-        atom_avstat[h].rent = (w * stiRent);
+        atom_avstat[targetSet[i]].rent = (w * stiRent);
 #endif
-
     }
 
+    _bank->change_av(targetSet, avs);
+
     // update elapsed time
     last_update = high_resolution_clock::now();
 }
@@ -51,11 +51,16 @@ namespace opencog {
      * computed as a linear function form the Funds and a Target Value.
      * It is capped to the range 0-2x default Wage.
      *
+     * Rent is collected at most AF_RENT_FREQUENCY times a second, and is
+     * weighted by the time since it was last collected, so that the same
+     * rent is taken per second however often the agent gets to run.
+     *
      * This Agent is supposed to run in it's own Thread.
      */
     class AFRentCollectionAgent : public RentCollectionBaseAgent {
         private:
             time_point<high_resolution_clock> last_update;
+            bool started;
             float update_freq;
 
         public:
@@ -0,0 +1,81 @@
+/*
+ * opencog/attention/AgentBudget.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <mutex>
+
+#include "AgentBudget.h"
+
+using namespace opencog;
+
+static std::mutex _statsMtx;
+static std::map<std::string, AgentBudgetStats> _stats;
+
+static thread_local double _threadSlice = 0;
+
+AgentBudget::AgentBudget(const std::string& agent) :
+    _agent(agent), _millis(0), _deferred(false)
+{
+}
+
+void AgentBudget::set_thread_slice(double millis)
+{
+    _threadSlice = millis;
+}
+
+void AgentBudget::start(double millis)
+{
+    if (0 < _threadSlice and (millis <= 0 or _threadSlice < millis))
+        millis = _threadSlice;
+
+    _millis = millis;
+    _deferred = false;
+    _start = clock::now();
+    _deadline = _start + std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double, std::milli>(std::max(0.0, millis)));
+}
+
+void AgentBudget::stop(void)
+{
+    double elapsed = std::chrono::duration<double, std::milli>(
+            clock::now() - _start).count();
+
+    std::lock_guard<std::mutex> lock(_statsMtx);
+    AgentBudgetStats& s = _stats[_agent];
+    s.runs++;
+    if (_deferred) s.deferred++;
+    if (0 < _millis and elapsed > _millis) s.overruns++;
+    s.total_ms += elapsed;
+    s.max_ms = std::max(s.max_ms, elapsed);
+}
+
+std::map<std::string, AgentBudgetStats> opencog::agent_budget_stats(void)
+{
+    std::lock_guard<std::mutex> lock(_statsMtx);
+    return _stats;
+}
+
+void opencog::reset_agent_budget_stats(void)
+{
+    std::lock_guard<std::mutex> lock(_statsMtx);
+    _stats.clear();
+}
@@ -0,0 +1,101 @@
+/*
+ * opencog/attention/AgentBudget.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_AGENT_BUDGET_H
+#define _OPENCOG_AGENT_BUDGET_H
+
+#include <chrono>
+#include <map>
+#include <string>
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/**
+ * How the runs of one agent went against their budget.
+ */
+struct AgentBudgetStats
+{
+    size_t runs = 0;
+    size_t deferred = 0;   // Runs that left work for the next run
+    size_t overruns = 0;   // Runs that took longer than their budget
+    double total_ms = 0;
+    double max_ms = 0;
+};
+
+/**
+ * Time budget for the runs of an agent.
+ *
+ * An agent calls start() at the beginning of each run, with the budget
+ * in milliseconds, checks exhausted() between units of work, and calls
+ * defer() if it stops with work left, which it then picks up again on
+ * its next run. stop() records the run in the statistics of the agent.
+ * A budget of zero never runs out.
+ *
+ * Work is only checked between units, so a run may overshoot its
+ * budget by up to one unit; such runs are counted as overruns.
+ *
+ * A cooperative scheduler can cap every budget started on its thread
+ * with set_thread_slice(), which makes the checks between units into
+ * points where the agents yield to one another.
+ */
+class AgentBudget
+{
+private:
+    typedef std::chrono::steady_clock clock;
+
+    std::string _agent;
+    double _millis;
+    bool _deferred;
+    clock::time_point _start;
+    clock::time_point _deadline;
+
+public:
+    AgentBudget(const std::string& agent);
+
+    void start(double millis);
+    void stop(void);
+
+    bool unlimited(void) const { return _millis <= 0; }
+    bool exhausted(void) const
+    {
+        return 0 < _millis and clock::now() >= _deadline;
+    }
+
+    void defer(void) { _deferred = true; }
+
+    /// Caps the budgets started on the calling thread at the given
+    /// number of milliseconds; zero lifts the cap.
+    static void set_thread_slice(double millis);
+};
+
+/// The statistics of every agent that has recorded a run, by name.
+std::map<std::string, AgentBudgetStats> agent_budget_stats(void);
+void reset_agent_budget_stats(void);
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_AGENT_BUDGET_H
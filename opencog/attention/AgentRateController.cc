@@ -0,0 +1,271 @@
+/*
+ * opencog/attention/AgentRateController.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+#include "AgentRateController.h"
+
+using namespace opencog;
+using namespace std::placeholders;
+
+// Seconds between two rounds of rate setting.
+static const double CONTROL_PERIOD = 1.0;
+
+// Weight of a new measurement in the smoothed ones.
+static const double SMOOTHING = 0.2;
+
+// No managed agent is paced below this many runs per second.
+static const double MIN_RATE = 0.1;
+
+// Longest a begin() sleeps, so that a paced agent can still be stopped.
+static const std::chrono::milliseconds MAX_WAIT(100);
+
+AgentRateController::AgentRateController(AtomSpace* as) :
+    _bank(&attentionbank(as)), _atq(as), _lastUpdate(clock::now()),
+    _lastAVChanges(0), _lastAFChanges(0), _avRate(0), _afRate(0),
+    _avChanges(0), _afChanges(0)
+{
+    _avConnection = _bank->getAVChangedSignal().connect(
+            std::bind(&AgentRateController::avChangedHandler,
+                      this, _1, _2, _3));
+    _addAFConnection = _bank->AddAFSignal().connect(
+            std::bind(&AgentRateController::afChangedHandler,
+                      this, _1, _2, _3));
+    _removeAFConnection = _bank->RemoveAFSignal().connect(
+            std::bind(&AgentRateController::afChangedHandler,
+                      this, _1, _2, _3));
+}
+
+AgentRateController::~AgentRateController()
+{
+    _bank->getAVChangedSignal().disconnect(_avConnection);
+    _bank->AddAFSignal().disconnect(_addAFConnection);
+    _bank->RemoveAFSignal().disconnect(_removeAFConnection);
+}
+
+void AgentRateController::avChangedHandler(const Handle& h,
+        const AttentionValuePtr& old_av, const AttentionValuePtr& new_av)
+{
+    _avChanges++;
+}
+
+void AgentRateController::afChangedHandler(const Handle& h,
+        const AttentionValuePtr& old_av, const AttentionValuePtr& new_av)
+{
+    _afChanges++;
+}
+
+/*
+ * How far the STI funds are from their target, in units of the funds
+ * buffer, capped at one.
+ */
+double AgentRateController::imbalance(const EcanParams& params) const
+{
+    if (params.rent_sti_funds_buffer <= 0) return 0;
+
+    double diff = params.rent_target_sti_funds - _bank->getSTIFunds();
+    return std::min(1.0, std::fabs(diff) / params.rent_sti_funds_buffer);
+}
+
+/*
+ * Once every CONTROL_PERIOD, measures the AV change and AF churn rates
+ * and sets the rate of every managed agent. Agents that have not run yet
+ * have no cost to go by, and stay unpaced until they have.
+ */
+void AgentRateController::update(clock::time_point now)
+{
+    double dt = std::chrono::duration<double>(now - _lastUpdate).count();
+    if (dt < CONTROL_PERIOD) return;
+
+    size_t av = _avChanges;
+    size_t af = _afChanges;
+    _avRate = (av - _lastAVChanges) / dt;
+    _afRate = (af - _lastAFChanges) / dt;
+    _lastAVChanges = av;
+    _lastAFChanges = af;
+    _lastUpdate = now;
+
+    EcanParamsPtr params = _atq.params();
+    double share = params->agent_cpu_share;
+    double imb = imbalance(*params);
+    double churn = 0 < _avRate ? std::min(1.0, _afRate / _avRate) : 0;
+
+    double maxGain = 0;
+    for (const auto& p : _agents)
+        if (p.second.rate.managed)
+            maxGain = std::max(maxGain, p.second.rate.funds_gain);
+
+    auto weight = [&](const AgentRate& r)
+    {
+        double w = 1 + churn * r.stability;
+        if (0 < maxGain) w += imb * std::max(0.0, r.funds_gain) / maxGain;
+        return w;
+    };
+
+    double total = 0;
+    for (const auto& p : _agents)
+        if (p.second.rate.managed and 0 < p.second.rate.runs)
+            total += weight(p.second.rate);
+
+    for (auto& p : _agents)
+    {
+        AgentRate& r = p.second.rate;
+        if (share <= 0 or not r.managed or 0 == r.runs) {
+            r.rate = 0;
+            continue;
+        }
+
+        // Milliseconds per second allowed to this agent.
+        double ms = 1000 * share * weight(r) / total;
+        r.rate = std::max(MIN_RATE, ms / std::max(r.cost_ms, 0.01));
+    }
+}
+
+void AgentRateController::manage(const std::string& agent)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _agents[agent].rate.managed = true;
+}
+
+void AgentRateController::release(const std::string& agent)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _agents.find(agent);
+    if (it == _agents.end()) return;
+    it->second.rate.managed = false;
+    it->second.rate.rate = 0;
+}
+
+/*
+ * Returns false if the agent is paced and its next run is not yet due.
+ * Rather than have the agent spin, it first sleeps until the run is due,
+ * or for MAX_WAIT if that is sooner.
+ */
+bool AgentRateController::begin(const std::string& agent)
+{
+    clock::time_point now = clock::now();
+    clock::duration wait = clock::duration::zero();
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        update(now);
+
+        const AgentRate& r = _agents[agent].rate;
+        if (r.managed and 0 < r.rate) {
+            clock::time_point due = _agents[agent].last +
+                std::chrono::duration_cast<clock::duration>(
+                    std::chrono::duration<double>(1 / r.rate));
+            if (now < due) wait = due - now;
+        }
+    }
+
+    if (wait > clock::duration::zero()) {
+        std::this_thread::sleep_for(std::min<clock::duration>(wait, MAX_WAIT));
+        if (wait > MAX_WAIT) {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _agents[agent].rate.skipped++;
+            return false;
+        }
+        now = clock::now();
+    }
+
+    double imb = imbalance(*_atq.params());
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    State& s = _agents[agent];
+    s.last = now;
+    s.begun = now;
+    s.imbalance = imb;
+    s.avChanges = _avChanges;
+    s.afChanges = _afChanges;
+    return true;
+}
+
+/*
+ * Folds the cost and the effect of the run that just ended into the
+ * agent's smoothed measurements. Other agents may have been running at
+ * the same time, so these are estimates; the smoothing evens them out.
+ */
+void AgentRateController::end(const std::string& agent)
+{
+    clock::time_point now = clock::now();
+    double imb = imbalance(*_atq.params());
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _agents.find(agent);
+    if (it == _agents.end()) return;
+
+    State& s = it->second;
+    AgentRate& r = s.rate;
+    double ms = std::chrono::duration<double, std::milli>(now - s.begun).count();
+    double gain = s.imbalance - imb;
+    size_t av = _avChanges - s.avChanges;
+    size_t af = _afChanges - s.afChanges;
+
+    auto smooth = [&](double& avg, double x)
+    {
+        avg = 0 == r.runs ? x : (1 - SMOOTHING) * avg + SMOOTHING * x;
+    };
+
+    smooth(r.cost_ms, ms);
+    smooth(r.funds_gain, gain);
+    if (0 < av)
+        smooth(r.stability, 1 - std::min(1.0, double(af) / av));
+    r.runs++;
+}
+
+std::map<std::string, AgentRate> AgentRateController::rates(void)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    std::map<std::string, AgentRate> result;
+    for (const auto& p : _agents)
+        result[p.first] = p.second.rate;
+    return result;
+}
+
+double AgentRateController::av_change_rate(void)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _avRate;
+}
+
+double AgentRateController::af_churn_rate(void)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _afRate;
+}
+
+std::shared_ptr<AgentRateController> opencog::agent_rate_controller(AtomSpace* as)
+{
+    static std::mutex _mtx;
+    static std::map<AtomSpace*, std::weak_ptr<AgentRateController>> _controllers;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    std::shared_ptr<AgentRateController> ctl = _controllers[as].lock();
+    if (nullptr == ctl) {
+        ctl = std::make_shared<AgentRateController>(as);
+        _controllers[as] = ctl;
+    }
+    return ctl;
+}
@@ -0,0 +1,149 @@
+/*
+ * opencog/attention/AgentRateController.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_AGENT_RATE_CONTROLLER_H
+#define _OPENCOG_AGENT_RATE_CONTROLLER_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+
+#include "AttentionParamQuery.h"
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/**
+ * What the controller knows about one agent, and the rate it chose.
+ */
+struct AgentRate
+{
+    bool managed = false;  // Paced by the controller
+    double rate = 0;       // Runs per second allowed; 0 if not paced
+    double cost_ms = 0;    // Smoothed time per run
+    double funds_gain = 0; // Smoothed STI funds imbalance removed per run
+    double stability = 0;  // Smoothed share of its AV changes that left
+                           // the AF alone
+    size_t runs = 0;
+    size_t skipped = 0;    // Runs turned away as not yet due
+};
+
+/**
+ * Paces the ECAN agents so that together they use about AGENT_CPU_SHARE
+ * of one core.
+ *
+ * Each agent calls begin() at the start of a run, and skips the run if
+ * it returns false, and calls end() when the run is done. In between,
+ * the controller measures the run's time, how far it moved the STI
+ * funds towards their target, and how many of the AV changes made
+ * during the run moved an atom into or out of the AF. These are
+ * smoothed per agent.
+ *
+ * Once a second, the time allowed per second is split between the
+ * agents by weight, and turned into a rate using each agent's cost.
+ * Every agent has a weight of one, plus its share of the funds gains
+ * times the current funds imbalance, plus its stability times the
+ * current AF churn, the share of AV changes that moved an atom across
+ * the AF boundary. So agents that bring the funds back to target are
+ * favoured while the funds are off, and agents that change AVs without
+ * churning the AF are favoured while the AF churns.
+ *
+ * Only agents handed to manage() are paced; AttentionModule does this
+ * for the agents it schedules. Others, such as those run inline by the
+ * EcanPipelineAgent, pass straight through. A share of zero paces no
+ * one, but the measurements are still taken.
+ */
+class AgentRateController
+{
+private:
+    typedef std::chrono::steady_clock clock;
+
+    struct State
+    {
+        AgentRate rate;
+        clock::time_point last;    // Start of the last admitted run
+        clock::time_point begun;
+        double imbalance = 0;
+        size_t avChanges = 0;
+        size_t afChanges = 0;
+    };
+
+    AttentionBank* _bank;
+    AttentionParamQuery _atq;
+
+    std::mutex _mtx; // Guards everything below
+    std::map<std::string, State> _agents;
+    clock::time_point _lastUpdate;
+    size_t _lastAVChanges;
+    size_t _lastAFChanges;
+    double _avRate;
+    double _afRate;
+
+    std::atomic<size_t> _avChanges;
+    std::atomic<size_t> _afChanges;
+    int _avConnection;
+    int _addAFConnection;
+    int _removeAFConnection;
+
+    void avChangedHandler(const Handle&, const AttentionValuePtr&,
+                          const AttentionValuePtr&);
+    void afChangedHandler(const Handle&, const AttentionValuePtr&,
+                          const AttentionValuePtr&);
+
+    double imbalance(const EcanParams&) const;
+    void update(clock::time_point now);
+
+public:
+    AgentRateController(AtomSpace*);
+    ~AgentRateController();
+
+    void manage(const std::string& agent);
+    void release(const std::string& agent);
+
+    bool begin(const std::string& agent);
+    void end(const std::string& agent);
+
+    std::map<std::string, AgentRate> rates(void);
+
+    /// AV changes, and AF entries and exits, per second.
+    double av_change_rate(void);
+    double af_churn_rate(void);
+};
+
+/// Returns the controller of the given AtomSpace, creating it if there
+/// is none. It is shared by all callers, and lives as long as any of
+/// them holds it.
+std::shared_ptr<AgentRateController> agent_rate_controller(AtomSpace*);
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_AGENT_RATE_CONTROLLER_H
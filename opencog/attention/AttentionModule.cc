@@ -22,6 +22,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cstdio>
+
+#include "AgentBudget.h"
 #include "AttentionModule.h"
 #include "AttentionParamQuery.h"
 
@@ -39,13 +43,15 @@ concurrent_queue<Handle> AttentionModule::newAtomsInAV;
 DECLARE_MODULE(AttentionModule)
 
 AttentionModule::AttentionModule(CogServer& cs) :
-    Module(cs)
+    Module(cs), _ecanStarted(false)
 {
     init();
     do_start_ecan_register();
     do_stop_ecan_register();
     do_list_ecan_param_register();
     do_set_ecan_param_register();
+    do_ecan_budget_stats_register();
+    do_ecan_rates_register();
 }
 
 AttentionModule::~AttentionModule()
@@ -54,6 +60,11 @@ AttentionModule::~AttentionModule()
 
     _scheduler->unregisterAgent(AFImportanceDiffusionAgent::info().id);
     _scheduler->unregisterAgent(WAImportanceDiffusionAgent::info().id);
+    _scheduler->unregisterAgent(PushImportanceDiffusionAgent::info().id);
+    _scheduler->unregisterAgent(RandomWalkImportanceDiffusionAgent::info().id);
+    _scheduler->unregisterAgent(EcanPipelineAgent::info().id);
+    _scheduler->unregisterAgent(CooperativeEcanAgent::info().id);
+    _scheduler->unregisterAgent(ShardedWAAgent::info().id);
 
     _scheduler->unregisterAgent(ForgettingAgent::info().id);
     _scheduler->unregisterAgent(HebbianUpdatingAgent::info().id);
@@ -63,6 +74,8 @@ AttentionModule::~AttentionModule()
     do_stop_ecan_unregister();
     do_list_ecan_param_unregister();
     do_set_ecan_param_unregister();
+    do_ecan_budget_stats_unregister();
+    do_ecan_rates_unregister();
 
     attentionbank(&_cogserver.getAtomSpace()).AddAFSignal().disconnect(addAFConnection);
 
@@ -80,18 +93,25 @@ void AttentionModule::init()
     _scheduler = &agmod->get_scheduler();
 
     AttentionParamQuery _atq(&_cogserver.getAtomSpace());
+    _rates = agent_rate_controller(&_cogserver.getAtomSpace());
 
     // Set params
-    int af_size = std::stoi(_atq.get_param_value(AttentionParamQuery::af_max_size));
+    int af_size = _atq.params()->af_max_size;
     attentionbank(&_cogserver.getAtomSpace()).set_af_size(af_size);
     
     // New Thread based ECAN agents.
     _scheduler->registerAgent(AFImportanceDiffusionAgent::info().id, &afImportanceFactory);
     _scheduler->registerAgent(WAImportanceDiffusionAgent::info().id, &waImportanceFactory);
+    _scheduler->registerAgent(PushImportanceDiffusionAgent::info().id, &pushImportanceFactory);
+    _scheduler->registerAgent(RandomWalkImportanceDiffusionAgent::info().id, &walkImportanceFactory);
 
     _scheduler->registerAgent(AFRentCollectionAgent::info().id, &afRentFactory);
     _scheduler->registerAgent(WARentCollectionAgent::info().id, &waRentFactory);
 
+    _scheduler->registerAgent(EcanPipelineAgent::info().id, &pipelineFactory);
+    _scheduler->registerAgent(CooperativeEcanAgent::info().id, &coopFactory);
+    _scheduler->registerAgent(ShardedWAAgent::info().id, &shardedWAFactory);
+
     _scheduler->registerAgent(ForgettingAgent::info().id,          &forgettingFactory);
     _scheduler->registerAgent(HebbianCreationAgent::info().id,&hebbianCreationFactory);
     _scheduler->registerAgent(HebbianUpdatingAgent::info().id,&hebbianUpdatingFactory);
@@ -105,6 +125,7 @@ void AttentionModule::init()
 
     _afImportanceAgentPtr = _scheduler->createAgent(AFImportanceDiffusionAgent::info().id,false);
     _waImportanceAgentPtr = _scheduler->createAgent(WAImportanceDiffusionAgent::info().id,false);
+    _walkImportanceAgentPtr = _scheduler->createAgent(RandomWalkImportanceDiffusionAgent::info().id,false);
 
     _afRentAgentPtr = _scheduler->createAgent(AFRentCollectionAgent::info().id, false);
     _waRentAgentPtr = _scheduler->createAgent(WARentCollectionAgent::info().id, false);
@@ -117,31 +138,125 @@ void AttentionModule::init()
 
 std::string AttentionModule::do_start_ecan(Request *req, std::list<std::string> args)
 {
-    std::string afImportance = AFImportanceDiffusionAgent::info().id;
+    bool push = not args.empty() and args.front() == "push";
+    bool walk = not args.empty() and args.front() == "walk";
+    bool pipeline = not args.empty() and args.front() == "pipeline";
+    bool coop = not args.empty() and args.front() == "coop";
+    bool exclusive = std::find(args.begin(), args.end(), "exclusive") != args.end();
+    bool sharded = std::find(args.begin(), args.end(), "sharded") != args.end();
+
+    AttentionBank& bank = attentionbank(&_cogserver.getAtomSpace());
+
+    // Nothing may run beside an exclusive cooperative agent.
+    if (bank.is_exclusive())
+        return "The cooperative agent runs exclusively; "
+               "stop-ecan before starting other agents.\n";
+
+    if (pipeline) {
+        // Created on first use only, as it brings its own copies of the
+        // other agents.
+        if (nullptr == _pipelineAgentPtr)
+            _pipelineAgentPtr = _scheduler->createAgent(
+                    EcanPipelineAgent::info().id, false);
+        std::string id = EcanPipelineAgent::info().id;
+        _scheduler->startAgent(_pipelineAgentPtr, true, id);
+        _rates->manage(id);
+        _ecanStarted = true;
+        return "Started the following agents:\n" + id + "\n";
+    }
+
+    if (coop) {
+        // Created on first use only, as it brings its own copies of the
+        // agents it runs.
+        if (nullptr == _coopAgentPtr)
+            _coopAgentPtr = _scheduler->createAgent(
+                    CooperativeEcanAgent::info().id, false);
+
+        // Nothing else changes the bank from here on, so its locks can
+        // go; but only if the agents started before have been stopped.
+        if (exclusive) {
+            if (_ecanStarted)
+                return "Other ECAN agents are running; stop-ecan before "
+                       "'start-ecan coop exclusive'.\n";
+            bank.set_exclusive(true);
+        }
+
+        std::string id = CooperativeEcanAgent::info().id;
+        _scheduler->startAgent(_coopAgentPtr, true, id);
+        _rates->manage(id);
+        _ecanStarted = true;
+        return "Started the following agents:\n" + id + "\n";
+    }
+
+    std::string afImportance = push ? PushImportanceDiffusionAgent::info().id
+                             : walk ? RandomWalkImportanceDiffusionAgent::info().id
+                                    : AFImportanceDiffusionAgent::info().id;
     std::string waImportance = WAImportanceDiffusionAgent::info().id;
 
     std::string afRent = AFRentCollectionAgent::info().id;
     std::string waRent = WARentCollectionAgent::info().id;
 
-    _scheduler->startAgent(_afImportanceAgentPtr, true, afImportance);
-    _scheduler->startAgent(_waImportanceAgentPtr, true, waImportance);
-
+    std::string wa = sharded ? ShardedWAAgent::info().id
+                             : waImportance + "\n" + waRent;
+
+    if (push) {
+        // Created on first use only, as it starts collecting residuals
+        // as soon as it exists.
+        if (nullptr == _pushImportanceAgentPtr)
+            _pushImportanceAgentPtr = _scheduler->createAgent(
+                    PushImportanceDiffusionAgent::info().id, false);
+        _scheduler->startAgent(_pushImportanceAgentPtr, true, afImportance);
+    } else if (walk) {
+        _scheduler->startAgent(_walkImportanceAgentPtr, true, afImportance);
+    } else {
+        _scheduler->startAgent(_afImportanceAgentPtr, true, afImportance);
+    }
     _scheduler->startAgent(_afRentAgentPtr, true, afRent);
-    _scheduler->startAgent(_waRentAgentPtr, true, waRent);
+
+    if (sharded) {
+        // Does the work of both WA agents.
+        if (nullptr == _shardedWAAgentPtr)
+            _shardedWAAgentPtr = _scheduler->createAgent(
+                    ShardedWAAgent::info().id, false);
+        _scheduler->startAgent(_shardedWAAgentPtr, true, wa);
+    } else {
+        _scheduler->startAgent(_waImportanceAgentPtr, true, waImportance);
+        _scheduler->startAgent(_waRentAgentPtr, true, waRent);
+    }
+
+    // Pace the agents just started to hold AGENT_CPU_SHARE.
+    _rates->manage(afImportance);
+    _rates->manage(afRent);
+    if (sharded) {
+        _rates->manage(ShardedWAAgent::info().id);
+    } else {
+        _rates->manage(waImportance);
+        _rates->manage(waRent);
+    }
+    _ecanStarted = true;
 
    // _scheduler->startAgent(_forgetting_agentptr,true,"attention");
 
    // _scheduler->startAgent(_hebbiancreation_agentptr,true,"hca");
    // _scheduler->startAgent(_hebbianupdating_agentptr,true,"hua");
 
-    return ("Started the following agents:\n" + afImportance + "\n" + waImportance +
-           "\n" + afRent + "\n" + waRent + "\n");
+    return ("Started the following agents:\n" + afImportance + "\n" +
+            afRent + "\n" + wa + "\n");
 }
 
 std::string AttentionModule::do_stop_ecan(Request *req, std::list<std::string> args)
 {
     _scheduler->stopAgent(_afImportanceAgentPtr);
     _scheduler->stopAgent(_waImportanceAgentPtr);
+    if (_pushImportanceAgentPtr)
+        _scheduler->stopAgent(_pushImportanceAgentPtr);
+    _scheduler->stopAgent(_walkImportanceAgentPtr);
+    if (_pipelineAgentPtr)
+        _scheduler->stopAgent(_pipelineAgentPtr);
+    if (_coopAgentPtr)
+        _scheduler->stopAgent(_coopAgentPtr);
+    if (_shardedWAAgentPtr)
+        _scheduler->stopAgent(_shardedWAAgentPtr);
 
     _scheduler->stopAgent(_afRentAgentPtr);
     _scheduler->stopAgent(_waRentAgentPtr);
@@ -151,6 +266,13 @@ std::string AttentionModule::do_stop_ecan(Request *req, std::list<std::string> a
     _scheduler->stopAgent(_hebbiancreation_agentptr);
     _scheduler->stopAgent(_hebbianupdating_agentptr);
 
+    for (const auto& p : _rates->rates())
+        _rates->release(p.first);
+
+    // The cooperative agent, if it ran exclusively, has stopped.
+    attentionbank(&_cogserver.getAtomSpace()).set_exclusive(false);
+    _ecanStarted = false;
+
     return "Stopped ECAN agents.\n";
 }
 
@@ -177,6 +299,58 @@ std::string AttentionModule::do_set_ecan_param(Request *req, std::list<std::stri
    return param+"= "+_atq.get_param_value(param)+"\n";
 }
 
+std::string AttentionModule::do_ecan_budget_stats(Request *req, std::list<std::string> args)
+{
+    if (not args.empty() and args.front() == "reset") {
+        reset_agent_budget_stats();
+        return "Agent budget statistics reset.\n";
+    }
+
+    std::string response = "";
+    char line[256];
+    snprintf(line, sizeof(line), "%-45s %8s %9s %9s %9s %9s\n",
+             "agent", "runs", "deferred", "overruns", "mean ms", "max ms");
+    response += line;
+    for (const auto& p : agent_budget_stats()) {
+        const AgentBudgetStats& s = p.second;
+        snprintf(line, sizeof(line), "%-45s %8zu %9zu %9zu %9.2f %9.2f\n",
+                 p.first.c_str(), s.runs, s.deferred, s.overruns,
+                 s.runs ? s.total_ms / s.runs : 0.0, s.max_ms);
+        response += line;
+    }
+    return response;
+}
+
+std::string AttentionModule::do_ecan_rates(Request *req, std::list<std::string> args)
+{
+    AttentionParamQuery _atq(&_cogserver.getAtomSpace());
+
+    std::string response = "";
+    char line[256];
+    snprintf(line, sizeof(line),
+             "cpu share %.2f, %.1f AV changes/s, %.1f AF changes/s\n",
+             _atq.params()->agent_cpu_share, _rates->av_change_rate(),
+             _rates->af_churn_rate());
+    response += line;
+    snprintf(line, sizeof(line), "%-45s %9s %9s %11s %9s %8s %8s\n",
+             "agent", "runs/s", "cost ms", "funds gain", "stability",
+             "runs", "skipped");
+    response += line;
+    for (const auto& p : _rates->rates()) {
+        const AgentRate& r = p.second;
+        std::string rate = "-";
+        if (0 < r.rate) {
+            snprintf(line, sizeof(line), "%.2f", r.rate);
+            rate = line;
+        }
+        snprintf(line, sizeof(line), "%-45s %9s %9.2f %11.4f %9.3f %8zu %8zu\n",
+                 p.first.c_str(), rate.c_str(), r.cost_ms, r.funds_gain,
+                 r.stability, r.runs, r.skipped);
+        response += line;
+    }
+    return response;
+}
+
 
 /*
  * When an atom enters the AttentionalFocus, it is added to a concurrent_queue
@@ -31,11 +31,17 @@
 #include <opencog/cogserver/server/CogServer.h>
 #include <opencog/cogserver/modules/agents/Scheduler.h>
 
+#include "AgentRateController.h"
 #include "AFImportanceDiffusionAgent.h"
 #include "AFRentCollectionAgent.h"
 
 #include "WAImportanceDiffusionAgent.h"
+#include "PushImportanceDiffusionAgent.h"
+#include "RandomWalkImportanceDiffusionAgent.h"
 #include "WARentCollectionAgent.h"
+#include "EcanPipelineAgent.h"
+#include "CooperativeEcanAgent.h"
+#include "ShardedWAAgent.h"
 
 #include "ForgettingAgent.h"
 #include "HebbianUpdatingAgent.h"
@@ -55,10 +61,16 @@ private:
 
     Factory<AFImportanceDiffusionAgent, Agent>  afImportanceFactory;
     Factory<WAImportanceDiffusionAgent, Agent>  waImportanceFactory;
+    Factory<PushImportanceDiffusionAgent, Agent>  pushImportanceFactory;
+    Factory<RandomWalkImportanceDiffusionAgent, Agent>  walkImportanceFactory;
 
     Factory<AFRentCollectionAgent, Agent>  afRentFactory;
     Factory<WARentCollectionAgent, Agent>  waRentFactory;
 
+    Factory<EcanPipelineAgent, Agent>  pipelineFactory;
+    Factory<CooperativeEcanAgent, Agent>  coopFactory;
+    Factory<ShardedWAAgent, Agent>  shardedWAFactory;
+
     Factory<ForgettingAgent, Agent> forgettingFactory;
 
     Factory<HebbianUpdatingAgent, Agent> hebbianUpdatingFactory;
@@ -74,10 +86,22 @@ private:
 
     AgentPtr _afImportanceAgentPtr;
     AgentPtr _waImportanceAgentPtr;
+    AgentPtr _pushImportanceAgentPtr;
+    AgentPtr _walkImportanceAgentPtr;
 
     AgentPtr _waRentAgentPtr;
     AgentPtr _afRentAgentPtr;
 
+    AgentPtr _pipelineAgentPtr;
+    AgentPtr _coopAgentPtr;
+    AgentPtr _shardedWAAgentPtr;
+
+    std::shared_ptr<AgentRateController> _rates;
+
+    // Whether start-ecan has started agents that stop-ecan has not
+    // stopped yet.
+    bool _ecanStarted;
+
     int addAFConnection;
 
     void addAFSignal(const Handle& h, const AttentionValuePtr& av_old,
@@ -88,8 +112,18 @@ private:
 public:
 
     DECLARE_CMD_REQUEST(AttentionModule, "start-ecan", do_start_ecan,
-                        "Starts  ECAN agents. use agents-active command to view a list of agents started.\n",
-                        "Usage: start-ecan\n", false, true)
+                        "Starts  ECAN agents. use agents-active command to view a list of agents started.\n"
+                        "With 'push' or 'walk', the PushImportanceDiffusionAgent or the\n"
+                        "RandomWalkImportanceDiffusionAgent replaces the AF diffusion agent.\n"
+                        "With 'pipeline', a single EcanPipelineAgent runs all of them, one\n"
+                        "phase after the other, in one thread.\n"
+                        "With 'coop', a CooperativeEcanAgent runs the AF and WA agents\n"
+                        "as cooperative tasks on one thread; 'coop exclusive' also\n"
+                        "switches off the bank locks while it runs, and is refused while\n"
+                        "other ECAN agents are running.\n"
+                        "With 'sharded', a ShardedWAAgent replaces the WA diffusion and\n"
+                        "rent agents.\n",
+                        "Usage: start-ecan [push|walk|pipeline|coop] [sharded|exclusive]\n", false, true)
 
     DECLARE_CMD_REQUEST(AttentionModule, "stop-ecan", do_stop_ecan,
                         "Stops all active  ECAN agents\n",
@@ -104,6 +138,19 @@ public:
                         "Sets the value of an ecan parameter\n",
                         "Usage: set-ecan-param <param-name> <param-value> \n", false, true)
 
+    DECLARE_CMD_REQUEST(AttentionModule, "ecan-budget-stats", do_ecan_budget_stats,
+                        "Lists, for every ECAN agent, how its runs went against\n"
+                        "AGENT_RUN_BUDGET: runs, runs that left work for the next\n"
+                        "run, runs over budget, and the mean and longest run time.\n"
+                        "With 'reset', clears the statistics.\n",
+                        "Usage: ecan-budget-stats [reset]\n", false, true)
+
+    DECLARE_CMD_REQUEST(AttentionModule, "ecan-rates", do_ecan_rates,
+                        "Lists the rate, in runs per second, that each ECAN agent\n"
+                        "is held to so that together they use AGENT_CPU_SHARE of\n"
+                        "one core, with the run cost and effects it is based on.\n",
+                        "Usage: ecan-rates\n", false, true)
+
 
 
     static inline const char* id();
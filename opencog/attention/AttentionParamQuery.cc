@@ -22,12 +22,23 @@ const std::string AttentionParamQuery::forg_forgetting_threshold = "ECAN_FORGET_
 const std::string AttentionParamQuery::heb_maxlink = "MAX_LINKS";
 const std::string AttentionParamQuery::heb_max_alloc_percentage = "HEBBIAN_MAX_ALLOCATION_PERCENTAGE";
 const std::string AttentionParamQuery::heb_local_farlink_ratio = "LOCAL_FAR_LINK_RATIO";
+const std::string AttentionParamQuery::heb_dense_store = "HEBBIAN_DENSE_STORE";
+const std::string AttentionParamQuery::heb_persist_threshold = "HEBBIAN_PERSIST_THRESHOLD";
+const std::string AttentionParamQuery::heb_graph_store = "HEBBIAN_GRAPH_STORE";
 
 // Diffusion/Spreading Params
 const std::string AttentionParamQuery::dif_spread_percentage = "MAX_SPREAD_PERCENTAGE";
 const std::string AttentionParamQuery::dif_spread_hebonly = "SPREAD_HEBBIAN_ONLY";
 const std::string AttentionParamQuery::dif_tournament_size = "DIFFUSION_TOURNAMENT_SIZE";
 const std::string AttentionParamQuery::spreading_filter = "SPREADING_FILTER";
+const std::string AttentionParamQuery::dif_exact_decay = "DIFFUSION_EXACT_DECAY";
+const std::string AttentionParamQuery::dif_push_threshold = "DIFFUSION_PUSH_THRESHOLD";
+const std::string AttentionParamQuery::dif_jacobi_threads = "DIFFUSION_JACOBI_THREADS";
+const std::string AttentionParamQuery::dif_wa_batch_size = "WA_DIFFUSION_BATCH_SIZE";
+const std::string AttentionParamQuery::dif_incremental_epsilon = "DIFFUSION_INCREMENTAL_EPSILON";
+const std::string AttentionParamQuery::dif_walk_quantum = "DIFFUSION_WALK_QUANTUM";
+const std::string AttentionParamQuery::dif_walk_length = "DIFFUSION_WALK_LENGTH";
+const std::string AttentionParamQuery::dif_wa_shards = "WA_SHARDS";
 
 // Rent Params
 const std::string AttentionParamQuery::rent_starting_sti_rent = "STARTING_ATOM_STI_RENT";
@@ -38,6 +49,14 @@ const std::string AttentionParamQuery::rent_target_lti_funds = "TARGET_LTI_FUNDS
 const std::string AttentionParamQuery::rent_lti_funds_buffer = "LTI_FUNDS_BUFFER";
 const std::string AttentionParamQuery::rent_tournament_size = "RENT_TOURNAMENT_SIZE";
 
+// Pipeline Params
+const std::string AttentionParamQuery::pipeline_maintenance = "PIPELINE_MAINTENANCE";
+
+// Agent Params
+const std::string AttentionParamQuery::agent_run_budget = "AGENT_RUN_BUDGET";
+const std::string AttentionParamQuery::agent_cpu_share = "AGENT_CPU_SHARE";
+const std::string AttentionParamQuery::coop_slice = "COOP_SLICE";
+
 
 /**
  * The representation of parameters in the atomspace
@@ -64,6 +83,8 @@ AttentionParamQuery::AttentionParamQuery(AtomSpace* as): _as(as)
     Handle member = _as->add_link(MEMBER_LINK,
             HandleSeq {var, parent_param});
     hget_params = _as->add_link(BIND_LINK, HandleSeq{member, var});
+
+    _params = ecan_params_publisher(_as);
 }
 
 std::string AttentionParamQuery::get_param_value(std::string param)
@@ -30,6 +30,8 @@
 #include <opencog/atoms/atom_types/atom_types.h>
 #include <opencog/atomspace/AtomSpace.h>
 
+#include "EcanParams.h"
+
 namespace opencog
 {
     class AttentionParamQuery 
@@ -38,6 +40,7 @@ namespace opencog
             AtomSpace * _as;
             Handle parent_param; 
             Handle hget_params;
+            std::shared_ptr<EcanParamsPublisher> _params;
 
         public:
             // Attentional Focus Params
@@ -55,12 +58,23 @@ namespace opencog
             static const std::string heb_maxlink;
             static const std::string heb_max_alloc_percentage;
             static const std::string heb_local_farlink_ratio;
+            static const std::string heb_dense_store;
+            static const std::string heb_persist_threshold;
+            static const std::string heb_graph_store;
 
             // Diffusion/Spreading Params
             static const std::string dif_spread_percentage;
             static const std::string dif_spread_hebonly;
             static const std::string dif_tournament_size;
             static const std::string spreading_filter;
+            static const std::string dif_exact_decay;
+            static const std::string dif_push_threshold;
+            static const std::string dif_jacobi_threads;
+            static const std::string dif_wa_batch_size;
+            static const std::string dif_incremental_epsilon;
+            static const std::string dif_walk_quantum;
+            static const std::string dif_walk_length;
+            static const std::string dif_wa_shards;
 
             // Rent Params
             static const std::string rent_starting_sti_rent;
@@ -71,6 +85,14 @@ namespace opencog
             static const std::string rent_lti_funds_buffer;
             static const std::string rent_tournament_size;
 
+            // Pipeline Params
+            static const std::string pipeline_maintenance;
+
+            // Agent Params
+            static const std::string agent_run_budget;
+            static const std::string agent_cpu_share;
+            static const std::string coop_slice;
+
             AttentionParamQuery(AtomSpace* as);
 
             void load_default_values(void);
@@ -78,6 +100,10 @@ namespace opencog
             Handle get_param_hvalue(std::string param);
             HandleSeq get_params(void);
 
+            /// Current typed snapshot of the numeric parameters; a
+            /// single atomic load, cheap enough to call on every cycle.
+            EcanParamsPtr params(void) const { return _params->get(); }
+
             template<class T>
                 void set_param(std::string param_name, T value)
                 {
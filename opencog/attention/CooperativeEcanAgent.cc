@@ -0,0 +1,57 @@
+/*
+ * opencog/attention/CooperativeEcanAgent.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "AgentBudget.h"
+#include "CooperativeEcanAgent.h"
+
+using namespace opencog;
+
+CooperativeEcanAgent::CooperativeEcanAgent(CogServer& cs) :
+    Agent(cs), _atq(&cs.getAtomSpace()),
+    _afDiffusion(cs), _afRent(cs), _waDiffusion(cs), _waRent(cs)
+{
+    _rates = agent_rate_controller(_as);
+    _tasks = {&_afDiffusion, &_afRent, &_waDiffusion, &_waRent};
+}
+
+CooperativeEcanAgent::~CooperativeEcanAgent()
+{
+}
+
+/*
+ * One round: every task gets one turn. The slice is set for this thread
+ * only, so the agents keep their own budgets when run elsewhere.
+ */
+void CooperativeEcanAgent::run()
+{
+    // Not yet due, if paced to hold AGENT_CPU_SHARE.
+    if (not _rates->begin(classinfo().id)) return;
+
+    AgentBudget::set_thread_slice(_atq.params()->coop_slice);
+    for (Agent* task : _tasks)
+        task->run();
+    AgentBudget::set_thread_slice(0);
+
+    _rates->end(classinfo().id);
+}
@@ -0,0 +1,93 @@
+/*
+ * opencog/attention/CooperativeEcanAgent.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_COOPERATIVE_ECAN_AGENT_H
+#define _OPENCOG_COOPERATIVE_ECAN_AGENT_H
+
+#include <memory>
+#include <vector>
+
+#include <opencog/cogserver/modules/agents/Agent.h>
+
+#include "AFImportanceDiffusionAgent.h"
+#include "AFRentCollectionAgent.h"
+#include "AgentRateController.h"
+#include "AttentionParamQuery.h"
+#include "WAImportanceDiffusionAgent.h"
+#include "WARentCollectionAgent.h"
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/** Runs the ECAN agents as cooperative tasks on a single thread.
+ *
+ * With each agent in a thread of its own, a unit of work that takes a
+ * few microseconds, such as one WA diffusion or one rent charge, can
+ * cost more in context switches and lock handoffs than in the work
+ * itself. This agent owns its own AF and WA diffusion and rent agents,
+ * and every run() gives each of them one turn, in a fixed order.
+ *
+ * A turn is one run() of the agent, with its AgentBudget capped at
+ * COOP_SLICE milliseconds. Agents that sweep resumably, such as the AF
+ * diffusion agent, yield at their budget checks once the slice is
+ * spent, and carry on from their cursor on their next turn. The rest do
+ * one short unit of work per turn anyway.
+ *
+ * As only this thread then changes the bank, "start-ecan coop exclusive"
+ * also switches off the bank's funds and AF locks; see
+ * AttentionBank::set_exclusive(). Nothing else may use the bank while
+ * this is so: start-ecan refuses the mode while other ECAN agents run,
+ * and a lock taken from any other thread fails an assertion.
+ */
+class CooperativeEcanAgent : public Agent
+{
+private:
+    AttentionParamQuery _atq;
+    std::shared_ptr<AgentRateController> _rates;
+
+    AFImportanceDiffusionAgent _afDiffusion;
+    AFRentCollectionAgent _afRent;
+    WAImportanceDiffusionAgent _waDiffusion;
+    WARentCollectionAgent _waRent;
+
+    // The turn order.
+    std::vector<Agent*> _tasks;
+
+public:
+    CooperativeEcanAgent(CogServer&);
+    virtual ~CooperativeEcanAgent();
+
+    virtual void run();
+    virtual const ClassInfo& classinfo() const { return info(); }
+    static const ClassInfo& info() {
+    static const ClassInfo _ci("opencog::CooperativeEcanAgent");
+        return _ci;
+    }
+};
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_COOPERATIVE_ECAN_AGENT_H
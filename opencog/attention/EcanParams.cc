@@ -0,0 +1,182 @@
+/*
+ * opencog/attention/EcanParams.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+#include <opencog/util/Logger.h>
+#include <opencog/atoms/core/StateLink.h>
+
+#include "AttentionParamQuery.h"
+#include "EcanParams.h"
+
+using namespace opencog;
+using namespace std::placeholders;
+
+typedef std::function<void(EcanParams&, const std::string&)> Setter;
+
+template<class T>
+static Setter field(T EcanParams::* f)
+{
+    return [f](EcanParams& p, const std::string& value)
+    {
+        p.*f = static_cast<T>(std::stod(value));
+    };
+}
+
+/*
+ * Maps each numeric parameter name to the field that holds it.
+ */
+static const std::unordered_map<std::string, Setter>& setters(void)
+{
+    typedef AttentionParamQuery Q;
+    static const std::unordered_map<std::string, Setter> _setters = {
+        {Q::af_size, field(&EcanParams::af_size)},
+        {Q::af_decay, field(&EcanParams::af_decay)},
+        {Q::af_bottom, field(&EcanParams::af_bottom)},
+        {Q::af_min_size, field(&EcanParams::af_min_size)},
+        {Q::af_max_size, field(&EcanParams::af_max_size)},
+        {Q::af_rent_update_freq, field(&EcanParams::af_rent_update_freq)},
+
+        {Q::forg_forgetting_threshold, field(&EcanParams::forg_forgetting_threshold)},
+
+        {Q::heb_maxlink, field(&EcanParams::heb_maxlink)},
+        {Q::heb_max_alloc_percentage, field(&EcanParams::heb_max_alloc_percentage)},
+        {Q::heb_local_farlink_ratio, field(&EcanParams::heb_local_farlink_ratio)},
+        {Q::heb_dense_store, field(&EcanParams::heb_dense_store)},
+        {Q::heb_persist_threshold, field(&EcanParams::heb_persist_threshold)},
+        {Q::heb_graph_store, field(&EcanParams::heb_graph_store)},
+
+        {Q::dif_spread_percentage, field(&EcanParams::dif_spread_percentage)},
+        {Q::dif_spread_hebonly, field(&EcanParams::dif_spread_hebonly)},
+        {Q::dif_tournament_size, field(&EcanParams::dif_tournament_size)},
+        {Q::dif_exact_decay, field(&EcanParams::dif_exact_decay)},
+        {Q::dif_push_threshold, field(&EcanParams::dif_push_threshold)},
+        {Q::dif_jacobi_threads, field(&EcanParams::dif_jacobi_threads)},
+        {Q::dif_wa_batch_size, field(&EcanParams::dif_wa_batch_size)},
+        {Q::dif_incremental_epsilon, field(&EcanParams::dif_incremental_epsilon)},
+        {Q::dif_walk_quantum, field(&EcanParams::dif_walk_quantum)},
+        {Q::dif_walk_length, field(&EcanParams::dif_walk_length)},
+        {Q::dif_wa_shards, field(&EcanParams::dif_wa_shards)},
+
+        {Q::rent_starting_sti_rent, field(&EcanParams::rent_starting_sti_rent)},
+        {Q::rent_starting_lti_rent, field(&EcanParams::rent_starting_lti_rent)},
+        {Q::rent_target_sti_funds, field(&EcanParams::rent_target_sti_funds)},
+        {Q::rent_sti_funds_buffer, field(&EcanParams::rent_sti_funds_buffer)},
+        {Q::rent_target_lti_funds, field(&EcanParams::rent_target_lti_funds)},
+        {Q::rent_lti_funds_buffer, field(&EcanParams::rent_lti_funds_buffer)},
+        {Q::rent_tournament_size, field(&EcanParams::rent_tournament_size)},
+
+        {Q::pipeline_maintenance, field(&EcanParams::pipeline_maintenance)},
+
+        {Q::agent_run_budget, field(&EcanParams::agent_run_budget)},
+        {Q::agent_cpu_share, field(&EcanParams::agent_cpu_share)},
+        {Q::coop_slice, field(&EcanParams::coop_slice)},
+    };
+    return _setters;
+}
+
+/*
+ * Sets the field of the named parameter from a NumberNode value.
+ * Returns false if the parameter is unknown or the value is not a
+ * number, in which case the field is left as it was.
+ */
+static bool assign(EcanParams& p, const std::string& param,
+                   const Handle& hvalue)
+{
+    auto it = setters().find(param);
+    if (it == setters().end()) return false;
+
+    if (nullptr == hvalue or not hvalue->is_node()) return false;
+
+    try {
+        it->second(p, hvalue->get_name());
+    }
+    catch (const std::exception&) {
+        logger().warn("[EcanParams] Ignoring non-numeric value %s for %s",
+                      hvalue->get_name().c_str(), param.c_str());
+        return false;
+    }
+    return true;
+}
+
+EcanParamsPublisher::EcanParamsPublisher(AtomSpace* as) : _as(as)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    // Connect first, so that no change made while the snapshot is being
+    // built is lost; the handler waits for the lock.
+    _addConnection = _as->atomAddedSignal().connect(
+            std::bind(&EcanParamsPublisher::atomAddedHandler, this, _1));
+
+    auto params = std::make_shared<EcanParams>();
+    for (const auto& p : setters()) {
+        Handle hparam = _as->get_node(CONCEPT_NODE, std::string(p.first));
+        if (nullptr == hparam) continue;
+        assign(*params, p.first, StateLink::get_state(hparam));
+    }
+
+    std::atomic_store(&_current, EcanParamsPtr(params));
+}
+
+EcanParamsPublisher::~EcanParamsPublisher()
+{
+    _as->atomAddedSignal().disconnect(_addConnection);
+}
+
+/*
+ * Setting a parameter adds a new StateLink for it, which replaces the
+ * previous one. The new value is taken from the link itself, so the
+ * AtomSpace is not queried from within the signal.
+ */
+void EcanParamsPublisher::atomAddedHandler(const Handle& h)
+{
+    if (h->get_type() != STATE_LINK) return;
+
+    const Handle& hparam = h->getOutgoingAtom(0);
+    if (hparam->get_type() != CONCEPT_NODE) return;
+    if (setters().find(hparam->get_name()) == setters().end()) return;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    auto params = std::make_shared<EcanParams>(*_current);
+    if (not assign(*params, hparam->get_name(), h->getOutgoingAtom(1)))
+        return;
+    params->version++;
+
+    std::atomic_store(&_current, EcanParamsPtr(params));
+}
+
+std::shared_ptr<EcanParamsPublisher> opencog::ecan_params_publisher(AtomSpace* as)
+{
+    static std::mutex _mtx;
+    static std::map<AtomSpace*, std::weak_ptr<EcanParamsPublisher>> _publishers;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    std::shared_ptr<EcanParamsPublisher> pub = _publishers[as].lock();
+    if (nullptr == pub) {
+        pub = std::make_shared<EcanParamsPublisher>(as);
+        _publishers[as] = pub;
+    }
+    return pub;
+}
@@ -0,0 +1,142 @@
+/*
+ * opencog/attention/EcanParams.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ECAN_PARAMS_H
+#define _OPENCOG_ECAN_PARAMS_H
+
+#include <memory>
+#include <mutex>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/**
+ * Typed values of the numeric ECAN parameters, named after the
+ * corresponding AttentionParamQuery constants. A parameter that is
+ * missing from the AtomSpace keeps the value from
+ * default-param-values.scm, so the defaults below must match that file;
+ * AttentionParamQueryUTest checks that they do. SPREADING_FILTER is not
+ * a number and is handled by the SpreadingFilter.
+ */
+struct EcanParams
+{
+    // Incremented every time a parameter changes.
+    unsigned long version = 0;
+
+    // Attentional Focus Params
+    double af_size = 0.2;
+    double af_decay = 0.05;
+    double af_bottom = 50;
+    unsigned int af_min_size = 500;
+    unsigned int af_max_size = 1000;
+    double af_rent_update_freq = 5;
+
+    // Forgetting Params
+    double forg_forgetting_threshold = 0.05;
+
+    // Hebbian Link Params
+    int heb_maxlink = 300;
+    double heb_max_alloc_percentage = 0.05;
+    int heb_local_farlink_ratio = 10;
+    bool heb_dense_store = false;
+    double heb_persist_threshold = 0.9;
+    bool heb_graph_store = false;
+
+    // Diffusion/Spreading Params
+    double dif_spread_percentage = 0.4;
+    bool dif_spread_hebonly = false;
+    int dif_tournament_size = 5;
+    bool dif_exact_decay = false;
+    double dif_push_threshold = 5;
+    unsigned int dif_jacobi_threads = 0;
+    unsigned int dif_wa_batch_size = 1;
+    double dif_incremental_epsilon = 0;
+    double dif_walk_quantum = 1;
+    unsigned int dif_walk_length = 1;
+    unsigned int dif_wa_shards = 4;
+
+    // Rent Params
+    double rent_starting_sti_rent = 1;
+    double rent_starting_lti_rent = 1;
+    double rent_target_sti_funds = 10000;
+    double rent_sti_funds_buffer = 10000;
+    double rent_target_lti_funds = 10000;
+    double rent_lti_funds_buffer = 10000;
+    int rent_tournament_size = 5;
+
+    // Pipeline Params
+    bool pipeline_maintenance = false;
+
+    // Agent Params
+    double agent_run_budget = 0;
+    double agent_cpu_share = 0;
+    double coop_slice = 1;
+};
+
+typedef std::shared_ptr<const EcanParams> EcanParamsPtr;
+
+/**
+ * Publishes the ECAN parameters of an AtomSpace as immutable EcanParams
+ * snapshots.
+ *
+ * The snapshot is built once from the parameter StateLinks, and rebuilt
+ * only when a new StateLink for one of the parameters is added, which
+ * is what AttentionParamQuery::set_param, the set-ecan-param command
+ * and a scheme (State ...) all do. Only the changed field is parsed,
+ * from the value in the new StateLink. Readers never take a lock; get()
+ * is a single atomic load, and the snapshot it returns stays valid for
+ * as long as it is held.
+ */
+class EcanParamsPublisher
+{
+private:
+    AtomSpace* _as;
+    std::mutex _mtx; // Serialises writers
+    EcanParamsPtr _current;
+    int _addConnection;
+
+    void atomAddedHandler(const Handle&);
+
+public:
+    EcanParamsPublisher(AtomSpace*);
+    ~EcanParamsPublisher();
+
+    EcanParamsPtr get(void) const
+    {
+        return std::atomic_load(&_current);
+    }
+};
+
+/// Returns the publisher of the given AtomSpace, creating it if there
+/// is none. It is shared by all callers, and lives as long as any of
+/// them holds it.
+std::shared_ptr<EcanParamsPublisher> ecan_params_publisher(AtomSpace*);
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_ECAN_PARAMS_H
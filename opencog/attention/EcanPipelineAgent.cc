@@ -0,0 +1,189 @@
+/*
+ * opencog/attention/EcanPipelineAgent.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/bank/AVUtils.h>
+
+#include "EcanPipelineAgent.h"
+#include "AttentionStat.h"
+
+using namespace opencog;
+
+EcanPipelineAgent::EcanPipelineAgent(CogServer& cs) :
+    ImportanceDiffusionBase(cs),
+    _afRent(cs), _waDiffusion(cs), _waRent(cs),
+    _hebbianCreation(cs), _hebbianUpdating(cs), _forgetting(cs),
+    _stiRent(0), _ltiRent(0), _rentStarted(false)
+{
+}
+
+EcanPipelineAgent::~EcanPipelineAgent()
+{
+}
+
+void EcanPipelineAgent::run()
+{
+    // Not yet due, if paced to hold AGENT_CPU_SHARE.
+    if (not _rates->begin(classinfo().id)) return;
+
+    // Every phase of this cycle sees the same parameters.
+    _params = _atq.params();
+    maxSpreadPercentage = _params->dif_spread_percentage;
+    hebbianMaxAllocationPercentage = _params->heb_max_alloc_percentage;
+    spreadHebbianOnly = _params->dif_spread_hebonly;
+    _spreadingFilter.refresh();
+    _hebbian = _stores->get(*_params);
+
+    spreadImportance();
+
+    _waDiffusion.run();
+    _waRent.run();
+
+    if (_params->pipeline_maintenance) {
+        _hebbianCreation.run();
+        _hebbianUpdating.run();
+        _forgetting.run();
+    }
+
+    _rates->end(classinfo().id);
+}
+
+/*
+ * The AF phases of the cycle: snapshot, diffusion, rent and commit.
+ */
+void EcanPipelineAgent::spreadImportance()
+{
+    snapshotFocus();
+    if (_focus.empty()) return;
+
+    computeDiffusion();
+    computeRent();
+    commit();
+}
+
+void EcanPipelineAgent::snapshotFocus(void)
+{
+    _focus.clear();
+    _bank->get_handle_set_in_attentional_focus(back_inserter(_focus));
+}
+
+/*
+ * Fills _atoms and _deltas with the STI change of every atom that gives
+ * or receives STI in AF diffusion. Every AF atom is given a slot, even
+ * if it does not diffuse, so that it can be charged rent.
+ */
+void EcanPipelineAgent::computeDiffusion(void)
+{
+    _atoms.clear();
+    _deltas.clear();
+
+    HandleSeq sources = _focus;
+    _spreadingFilter.filter(sources);
+    snapshotDeltas(std::move(sources),
+                   std::max(1u, _params->dif_jacobi_threads), _atoms, _deltas);
+
+    std::unordered_map<Handle, size_t> slot;
+    for (size_t i = 0; i < _atoms.size(); i++)
+        slot.emplace(_atoms[i], i);
+
+    _paysRent.assign(_atoms.size(), false);
+    for (const Handle& h : _focus) {
+        auto res = slot.emplace(h, _atoms.size());
+        if (res.second) {
+            _atoms.push_back(h);
+            _deltas.push_back(0);
+            _paysRent.push_back(true);
+        } else {
+            _paysRent[res.first->second] = true;
+        }
+    }
+}
+
+/*
+ * Works out the rent each AF atom pays this cycle, weighted by the time
+ * since rent was last collected, as in the AFRentCollectionAgent. No rent
+ * is due until 1/AF_RENT_FREQUENCY seconds have passed.
+ */
+void EcanPipelineAgent::computeRent(void)
+{
+    clock::time_point now = clock::now();
+    if (not _rentStarted) {
+        _lastRent = now;
+        _rentStarted = true;
+    }
+
+    _stiRent = 0;
+    _ltiRent = 0;
+
+    double freq = _params->af_rent_update_freq;
+    double elapsed = std::chrono::duration<double>(now - _lastRent).count();
+    if (elapsed < 1 / freq) return;
+
+    double w = elapsed * freq;
+    _afRent.load_params();
+    _stiRent = _afRent.calculate_STI_Rent() * w;
+    _ltiRent = _afRent.calculate_LTI_Rent() * w;
+    _lastRent = now;
+}
+
+/*
+ * Applies the diffusion and the rent to the current AVs and writes them
+ * all back in one bank update. As in the rent agent, no atom pays more
+ * than it has.
+ */
+void EcanPipelineAgent::commit(void)
+{
+    size_t n = _atoms.size();
+    std::vector<AttentionValuePtr> avs(n);
+    for (size_t i = 0; i < n; i++) {
+        AttentionValuePtr av = get_av(_atoms[i]);
+        AttentionValue::sti_t sti = av->getSTI() + _deltas[i];
+        AttentionValue::lti_t lti = av->getLTI();
+
+        if (_paysRent[i]) {
+            sti -= std::min(_stiRent, sti);
+            lti -= std::min(_ltiRent, lti);
+
+#ifdef LOG_AV_STAT
+            atom_avstat[_atoms[i]].rent = _stiRent;
+#endif
+        }
+
+        avs[i] = AttentionValue::createAV(sti, lti, av->getVLTI());
+    }
+
+    _bank->change_av(_atoms, avs);
+}
+
+/*
+ * Returns the total amount of STI that the atom will diffuse
+ *
+ * Calculated as the maximum spread percentage multiplied by the atom's STI
+ */
+AttentionValue::sti_t EcanPipelineAgent::calculateDiffusionAmount(Handle h)
+{
+    return (get_sti(h) * maxSpreadPercentage);
+}
@@ -0,0 +1,114 @@
+/*
+ * opencog/attention/EcanPipelineAgent.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ECAN_PIPELINE_AGENT_H
+#define _OPENCOG_ECAN_PIPELINE_AGENT_H
+
+#include <chrono>
+#include <vector>
+
+#include "AFRentCollectionAgent.h"
+#include "ForgettingAgent.h"
+#include "HebbianCreationAgent.h"
+#include "HebbianUpdatingAgent.h"
+#include "ImportanceDiffusionBase.h"
+#include "WAImportanceDiffusionAgent.h"
+#include "WARentCollectionAgent.h"
+
+class ImportanceDiffusionUTest;
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/** Runs a whole ECAN cycle, in fixed phases, from a single thread.
+ *
+ * An alternative to running the diffusion and rent agents each in a
+ * thread of their own, where they contend for the AF and bank locks and
+ * each takes its own copy of the AF. Every run() of this agent is one
+ * cycle:
+ *
+ * (1) The AF is copied once, and the parameters are read once.
+ * (2) AF diffusion is computed from that copy, Jacobi style, on
+ *     DIFFUSION_JACOBI_THREADS threads, into one STI change per atom.
+ * (3) The AF rent is computed, as the AFRentCollectionAgent would, for
+ *     every atom of the copy.
+ * (4) Diffusion and rent are committed together, in one bank update.
+ * (5) The whole-AtomSpace diffusion and rent agents run once.
+ * (6) If PIPELINE_MAINTENANCE is set, the hebbian creation and updating
+ *     agents run once, followed by one forgetting slice.
+ *
+ * Started with "start-ecan pipeline", in place of the separate agents.
+ */
+class EcanPipelineAgent : public ImportanceDiffusionBase
+{
+private:
+    friend class ::ImportanceDiffusionUTest;
+
+    typedef std::chrono::steady_clock clock;
+
+    AFRentCollectionAgent _afRent;
+    WAImportanceDiffusionAgent _waDiffusion;
+    WARentCollectionAgent _waRent;
+    HebbianCreationAgent _hebbianCreation;
+    HebbianUpdatingAgent _hebbianUpdating;
+    ForgettingAgent _forgetting;
+
+    EcanParamsPtr _params;
+
+    // Shared between the phases of a cycle.
+    HandleSeq _focus;
+    HandleSeq _atoms;
+    std::vector<AttentionValue::sti_t> _deltas;
+    std::vector<bool> _paysRent;
+    AttentionValue::sti_t _stiRent;
+    AttentionValue::lti_t _ltiRent;
+
+    bool _rentStarted;
+    clock::time_point _lastRent;
+
+    void snapshotFocus(void);
+    void computeDiffusion(void);
+    void computeRent(void);
+    void commit(void);
+
+    void spreadImportance();
+    AttentionValue::sti_t calculateDiffusionAmount(Handle);
+
+public:
+    EcanPipelineAgent(CogServer&);
+    virtual ~EcanPipelineAgent();
+
+    virtual void run();
+    virtual const ClassInfo& classinfo() const { return info(); }
+    static const ClassInfo& info() {
+    static const ClassInfo _ci("opencog::EcanPipelineAgent");
+        return _ci;
+    }
+};
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_ECAN_PIPELINE_AGENT_H
@@ -0,0 +1,112 @@
+/*
+ * opencog/attention/EcanSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifdef HAVE_GUILE
+
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/guile/SchemePrimitive.h>
+#include <opencog/guile/SchemeSmob.h>
+
+#include "AgentRateController.h"
+
+namespace opencog {
+
+/**
+ * Scheme bindings for the state of the ECAN agents, in the
+ * (opencog attention) module.
+ */
+class EcanSCM
+{
+protected:
+    static void* init_in_guile(void*);
+    static void init_in_module(void*);
+    void init(void);
+
+public:
+    EcanSCM(void);
+
+    ValuePtr agent_rates(void);
+};
+
+}
+
+using namespace opencog;
+
+EcanSCM::EcanSCM(void)
+{
+    static bool is_init = false;
+    if (is_init) return;
+    is_init = true;
+    scm_with_guile(init_in_guile, this);
+}
+
+void* EcanSCM::init_in_guile(void* self)
+{
+    scm_c_define_module("opencog attention", init_in_module, self);
+    scm_c_use_module("opencog attention");
+    return NULL;
+}
+
+void EcanSCM::init_in_module(void* data)
+{
+    EcanSCM* self = (EcanSCM*) data;
+    self->init();
+}
+
+void EcanSCM::init(void)
+{
+    define_scheme_primitive("ecan-agent-rates", &EcanSCM::agent_rates, this, "attention");
+}
+
+/*
+ * Returns one LinkValue per agent known to the rate controller, holding
+ * the agent's name and a FloatValue with its rate, cost in milliseconds,
+ * funds gain, stability, runs and skipped runs, as ecan-rates lists them.
+ */
+ValuePtr EcanSCM::agent_rates(void)
+{
+    AtomSpacePtr asp = SchemeSmob::ss_get_env_as("ecan-agent-rates");
+
+    std::vector<ValuePtr> agents;
+    for (const auto& p : agent_rate_controller(asp.get())->rates()) {
+        const AgentRate& r = p.second;
+        agents.push_back(createLinkValue(std::vector<ValuePtr>({
+            createStringValue(p.first),
+            createFloatValue(std::vector<double>({
+                r.rate, r.cost_ms, r.funds_gain, r.stability,
+                double(r.runs), double(r.skipped)}))})));
+    }
+    return createLinkValue(agents);
+}
+
+extern "C" {
+void opencog_ecan_init(void);
+};
+
+void opencog_ecan_init(void)
+{
+    static EcanSCM ecan;
+}
+
+#endif // HAVE_GUILE
@@ -22,6 +22,7 @@
  */
 
 #include <algorithm>
+#include <functional>
 #include <sstream>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -34,9 +35,10 @@
 #include "ForgettingAgent.h"
 
 using namespace opencog;
+using namespace std::placeholders;
 
 ForgettingAgent::ForgettingAgent(CogServer& cs) :
-    Agent(cs)
+    Agent(cs), _atq(&cs.getAtomSpace()), _budget(info().id)
 {
     _bank = &attentionbank(_as);
 
@@ -53,75 +55,124 @@ ForgettingAgent::ForgettingAgent(CogServer& cs) :
     //Todo: Make configurable
     maxSize = config().get_int("ECAN_ATOMSPACE_MAXSIZE", 10000);
     accDivSize = config().get_int("ECAN_ATOMSPACE_ACCEPTABLE_SIZE_SPREAD", 100);
+    sliceSize = config().get_int("ECAN_FORGET_SLICE_SIZE", 500);
+    sliceTime = config().get_int("ECAN_FORGET_SLICE_MS", 20);
+
+    std::string spillFile = config().get("ECAN_FORGET_SPILL_FILE", "");
+    if (not spillFile.empty())
+        _spillStore = atom_spill_store(_as, spillFile);
+
+    _forgetting = false;
+    _atomCount = _as->get_size();
+    _addConnection = _as->atomAddedSignal().connect(
+            std::bind(&ForgettingAgent::atomAddedHandler, this, _1));
+    _removeConnection = _as->atomRemovedSignal().connect(
+            std::bind(&ForgettingAgent::atomRemovedHandler, this, _1));
 
     // Provide a logger, but disable it initially
     setLogger(new opencog::Logger("ForgettingAgent.log", Logger::WARN, true));
 }
 
-ForgettingAgent::~ForgettingAgent() {}
+ForgettingAgent::~ForgettingAgent()
+{
+    _as->atomAddedSignal().disconnect(_addConnection);
+    _as->atomRemovedSignal().disconnect(_removeConnection);
+}
+
+void ForgettingAgent::atomAddedHandler(const Handle& h)
+{
+    _atomCount++;
+}
+
+void ForgettingAgent::atomRemovedHandler(const AtomPtr& atom)
+{
+    _atomCount--;
+}
 
 void ForgettingAgent::run()
 {
     _log->fine("=========== ForgettingAgent::run =======");
+
+    double budget = _atq.params()->agent_run_budget;
+    if (budget <= 0 or sliceTime < budget) budget = sliceTime;
+
+    _budget.start(budget);
     forget();
+    _budget.stop();
 }
 
 void ForgettingAgent::forget()
 {
-    HandleSeq atomsVector;
-    int count = 0;
-    int removalAmount;
-    bool recursive;
-
-    _as->get_handles_by_type(atomsVector, ATOM, true);
+    int asize = _atomCount;
+
+    // Start at the high watermark, stop at the low one.
+    if (not _forgetting) {
+        if (asize < (maxSize + accDivSize)) return;
+        _forgetting = true;
+        _ltiCursor.reset();
+        _log->debug("ForgettingAgent::forget - AtomSpace size %d, "
+                    "starting to forget", asize);
+    }
 
-    int asize = atomsVector.size();
-    if (asize < (maxSize + accDivSize)) {
+    int removalAmount = asize - (maxSize - accDivSize);
+    if (removalAmount <= 0) {
+        _forgetting = false;
         return;
     }
-
-    fprintf(stdout,"Forgetting Stuff, Atomspace Size: %d \n",asize);
-    // Sort atoms by lti, remove the lowest unless vlti is NONDISPOSABLE
-    std::sort(atomsVector.begin(), atomsVector.end(), ForgettingLTIThenTVAscendingSort(_as));
-
-    removalAmount = asize - (maxSize - accDivSize);
+    removalAmount = std::min(removalAmount, sliceSize);
     _log->info("ForgettingAgent::forget - will attempt to remove %d atoms", removalAmount);
 
-    for (unsigned int i = 0; i < atomsVector.size(); i++)
+    int count = 0;
+    bool exhausted = true;
+    HandleSeq removed;
+
+    // Visit atoms by ascending lti, remove the lowest unless vlti is
+    // NONDISPOSABLE. The index only looks as far as it is asked to, and
+    // each slice carries on from the atom the last one stopped at.
+    _bank->getLTIIndex().foreachAscending(forgetThreshold,
+        [&](const Handle& h)->bool
     {
-        if (get_lti(atomsVector[i]) <= forgetThreshold
-                and count < removalAmount)
+        if (count >= removalAmount or _budget.exhausted()) {
+            exhausted = false;
+            return false;
+        }
+        if (get_vlti(h) != AttentionValue::DISPOSABLE) return true;
+
+        // Already taken out along with an atom removed earlier.
+        if (nullptr == h->getAtomSpace()) return true;
+
+        std::string atomName = h->to_string();
+        _log->fine("Removing atom %s", atomName.c_str());
+        // TODO: do recursive remove if neighbours are not very important
+        IncomingSet iset = h->getIncomingSet(_as);
+        for (const Handle& in : iset)
         {
-            if (get_vlti(atomsVector[i]) == AttentionValue::DISPOSABLE )
-            {
-                std::string atomName = atomsVector[i]->to_string();
-                _log->fine("Removing atom %s", atomName.c_str());
-                // TODO: do recursive remove if neighbours are not very important
-                IncomingSet iset = atomsVector[i]->getIncomingSet(_as);
-                recursive = true;
-                for (const Handle& h : iset)
-                {
-                    if (h->get_type() != ASYMMETRIC_HEBBIAN_LINK) {
-                        recursive = false;
-                        break;
-                    }
-                }
-                if (!recursive)
-                    continue;
-
-                _bank->set_sti(atomsVector[i], 0);
-                _bank->set_lti(atomsVector[i], 0);
-                if (!_as->remove_atom(atomsVector[i],recursive)) {
-                    // Atom must have already been removed through having
-                    // previously removed atoms in it's outgoing set.
-                    _log->error("Couldn't remove atom %s", atomName.c_str());
-                }
-                count++;
-                count += iset.size();
-            }
-        } else {
-            break;
+            if (in->get_type() != ASYMMETRIC_HEBBIAN_LINK)
+                return true;
         }
-    }
+
+        if (!_as->remove_atom(h, true)) {
+            // Atom must have already been removed through having
+            // previously removed atoms in it's outgoing set.
+            _log->error("Couldn't remove atom %s", atomName.c_str());
+            return true;
+        }
+        removed.push_back(h);
+        removed.insert(removed.end(), iset.begin(), iset.end());
+        count++;
+        count += iset.size();
+        return true;
+    }, _ltiCursor);
+
+    // The atoms still carry their values, so they can be spilled now.
+    if (_spillStore) _spillStore->spill(removed);
+
+    // Settle the bank for the whole slice at once.
+    _bank->remove_atoms_from_bank(removed);
+
+    // Nothing left below the threshold; wait for the next high watermark.
+    if (exhausted) _forgetting = false;
+    else _budget.defer();
+
     _log->info("ForgettingAgent::forget - %d atoms removed.", count);
 }
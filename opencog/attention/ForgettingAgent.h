@@ -23,15 +23,21 @@
 #ifndef _OPENCOG_FORGETTING_AGENT_H
 #define _OPENCOG_FORGETTING_AGENT_H
 
+#include <atomic>
+#include <memory>
 #include <string>
 
 #include <math.h>
 
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/bank/AtomSpillStore.h>
 #include <opencog/attentionbank/bank/AttentionBank.h>
 #include <opencog/attentionbank/avalue/AttentionValue.h>
 #include <opencog/cogserver/modules/agents/Agent.h>
 
+#include "AgentBudget.h"
+#include "AttentionParamQuery.h"
+
 namespace opencog
 {
 /** \addtogroup grp_attention
@@ -60,12 +66,39 @@ namespace opencog
  * 2. A range value of what is an accepteable deviation from that. (Allows the agent to run less often and delete more atoms in one go)
  *
  * These work in concert to limit how much and what atoms are forgotten.
+ * Forgetting starts once the AtomSpace grows past maxSize + accDivSize,
+ * and carries on until it is back down to maxSize - accDivSize. The size
+ * is tracked from the AtomSpace add and remove signals, rather than
+ * counted on every run.
+ *
+ * The removals are spread over as many runs as needed, so that other
+ * agents are not stalled: each run removes at most sliceSize atoms, and
+ * stops early once it has taken sliceTime milliseconds, or AGENT_RUN_BUDGET
+ * milliseconds if that is set and shorter.
+ *
+ * If ECAN_FORGET_SPILL_FILE names a file, forgotten atoms are spilled to
+ * it together with their AVs and TVs before they are removed, and come
+ * back when referenced or stimulated again. The store is shared with the
+ * other ForgettingAgents of the AtomSpace; see atom_spill_store().
  * TODO: Improve Recursive Remove to work with links outher then HebbianLinks
  */
 class ForgettingAgent : public Agent
 {
 private:
     AttentionBank* _bank;
+    AttentionParamQuery _atq;
+    AgentBudget _budget;
+
+    std::shared_ptr<AtomSpillStore> _spillStore;
+
+    std::atomic<int> _atomCount;
+    bool _forgetting;
+    LTIIndex::Cursor _ltiCursor; // Where the last slice stopped
+    int _addConnection;
+    int _removeConnection;
+
+    void atomAddedHandler(const Handle&);
+    void atomRemovedHandler(const AtomPtr&);
 
 public:
 
@@ -83,6 +116,11 @@ public:
     //!acceptable diviation from maxSize;
     int accDivSize;
 
+    //! Maximum number of atoms removed per run
+    int sliceSize;
+    //! Maximum time, in milliseconds, spent removing atoms per run
+    int sliceTime;
+
     ForgettingAgent(CogServer&);
     virtual ~ForgettingAgent();
     virtual void run();
@@ -96,7 +134,8 @@ typedef std::shared_ptr<ForgettingAgent> ForgettingAgentPtr;
 /**
  * Comparison operator for using qsort on a list of Handles.
  * Returns them with ascending LTI and if equal in LTI,
- * then sorted ascending by TruthValue.
+ * then sorted ascending by TruthValue. This is the order in which
+ * LTIIndex::foreachAscending visits atoms.
  */
 struct ForgettingLTIThenTVAscendingSort
 {
@@ -19,13 +19,13 @@
  * Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
+#include <set>
+
 #include <opencog/util/Config.h>
 #include <opencog/util/algorithm.h>
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Link.h>
-#include <opencog/atoms/truthvalue/IndefiniteTruthValue.h>
-#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
 #include <opencog/attentionbank/types/atom_types.h>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -35,7 +35,7 @@
 #include "AttentionModule.h"
 #include "AttentionUtils.h"
 #include "HebbianCreationAgent.h"
-#include "Neighbors.h"
+#include "HebbianStore.h"
 
 #ifdef DEBUG
 #undef DEBUG
@@ -44,9 +44,11 @@
 using namespace opencog;
 
 HebbianCreationAgent::HebbianCreationAgent(CogServer& cs) :
-    Agent(cs), _atq(&cs.getAtomSpace()), maxLinkNum(0), localToFarLinks(0)
+    Agent(cs), _atq(&cs.getAtomSpace()), _budget(info().id),
+    maxLinkNum(0), localToFarLinks(0)
 {
     _bank = &attentionbank(_as);
+    _stores = hebbian_store_selector(_as);
 
     // Provide a logger, but disable it initially
     setLogger(new opencog::Logger("HebbianCreationAgent.log", Logger::FINE, true));
@@ -54,108 +56,93 @@ HebbianCreationAgent::HebbianCreationAgent(CogServer& cs) :
 
 void HebbianCreationAgent::run()
 {
-    maxLinkNum = std::stoi(_atq.get_param_value
-                           (AttentionParamQuery::heb_maxlink));
-    localToFarLinks = std::stoi(_atq.get_param_value
-                               (AttentionParamQuery::heb_local_farlink_ratio));
+    EcanParamsPtr params = _atq.params();
+    maxLinkNum = params->heb_maxlink;
+    localToFarLinks = params->heb_local_farlink_ratio;
+    HebbianStorePtr store = _stores->get(*params);
+
+    _budget.start(params->agent_run_budget);
+    createHebbians(*store);
+    _budget.stop();
+}
 
+void HebbianCreationAgent::createHebbians(HebbianStore& store)
+{
+    // Take every atom that entered the AF since the last run, after any
+    // left over from the last run.
     Handle source;
-    if (AttentionModule::newAtomsInAV.is_empty())
-      return;
-
-    AttentionModule::newAtomsInAV.pop(source);
-    if (source == Handle::UNDEFINED)
+    while (AttentionModule::newAtomsInAV.try_get(source)) {
+        // HebbianLinks should not normally enter to the AF boundary since they
+        // should not normally have STI values.The below check will avoid such
+        // Scenarios from happening which could lead to HebbianLink creation
+        // bn atoms containing HebbianLink.
+        if (source == Handle::UNDEFINED or
+            nameserver().isA(source->get_type(), HEBBIAN_LINK))
+            continue;
+        _pending.push_back(source);
+    }
+    if (_pending.empty())
         return;
 
-    // HebbianLinks should not normally enter to the AF boundary since they
-    // should not normally have STI values.The below check will avoid such
-    // Scenarios from happening which could lead to HebbianLink creation
-    // bn atoms containing HebbianLink.
-    if (nameserver().isA(source->get_type(), HEBBIAN_LINK))
-        return;
+    // Retrieve the atoms in the AttentionalFocus, once for all sources.
+    HandleSeq attentionalFocus;
+    _bank->get_handle_set_in_attentional_focus(std::back_inserter(attentionalFocus));
 
-    // Retrieve the atoms in the AttentionalFocus
-    HandleSet attentionalFocus;
-    _bank->get_handle_set_in_attentional_focus(std::inserter(attentionalFocus,attentionalFocus.begin()));
-  
     // Remove HebbianLinks. if AF is not full HebbianLinks might be inserted
     // into AF when set_sti function is called.
-    HandleSeq attentionalF(attentionalFocus.begin(), attentionalFocus.end());
-    removeHebbianLinks(attentionalF);
-    attentionalFocus = HandleSet(attentionalF.begin(),attentionalF.end());
-
-    // Exclude the source atom
-    attentionalFocus.erase(source);
-
-    // Get the neighboring atoms, where the connecting edge
-    // is an AsymmetricHebbianLink in either direction
-    HandleSeq existingAsSourceHS =
-            get_target_neighbors(source, ASYMMETRIC_HEBBIAN_LINK);
-    HandleSeq existingAsTargetHS =
-            get_source_neighbors(source, ASYMMETRIC_HEBBIAN_LINK);
-
-    HandleSet existingAsSource(existingAsSourceHS.begin(),existingAsSourceHS.end());
-    HandleSet existingAsTarget(existingAsTargetHS.begin(),existingAsTargetHS.end());
-
-    // Get the set differences between the AttentionalFocus
-    // and the sets of existing sources and targets
-    HandleSet needToBeSource = set_difference(attentionalFocus,
-                                              existingAsSource);
-    HandleSet needToBeTarget = set_difference(attentionalFocus,
-                                              existingAsTarget);
-
-    int count = 0;
-
-    // Resulting in the sets of nodes that require
-    // a new AsymmetricHebbianLink in either direction
-    for (const Handle atom : needToBeSource) {
-        addHebbian(atom,source);
-    }
-
-    for (const Handle atom : needToBeTarget) {
-        addHebbian(source,atom);
-        count++;
-    }
+    removeHebbianLinks(attentionalFocus);
+
+    // The AsymmetricHebbianLinks that are missing, in either direction,
+    // between each source and the rest of the AF. A set, so that a pair
+    // of sources does not get its links twice.
+    std::set<std::pair<Handle, Handle>> missing;
+    HandleSeq sources;
+    while (not _pending.empty())
+    {
+        Handle src = _pending.front();
+        _pending.pop_front();
+
+        // Removed from the AtomSpace while it was waiting.
+        if (nullptr == src->getAtomSpace()) continue;
+        sources.push_back(src);
+
+        UnorderedHandleSet targets;
+        for (const HebbianStore::Weight& w : store.row(src))
+            targets.insert(w.target);
+        HandleSeq sourcesHS = store.sources(src);
+        UnorderedHandleSet linkedFrom(sourcesHS.begin(), sourcesHS.end());
+
+        int count = 0;
+        for (const Handle& atom : attentionalFocus)
+        {
+            if (atom == src) continue;
+            if (not linkedFrom.count(atom))
+                missing.emplace(atom, src);
+            if (not targets.count(atom)) {
+                missing.emplace(src, atom);
+                count++;
+            }
+        }
 
         //How many links outside the AF should be created
         int farLinks = round(count / localToFarLinks);
 
-        //Pick a random target and create the link if it doesn't exist already
-        for (int i = 0; i < farLinks; i++) {
-            Handle target = _bank->getRandomAtomNotInAF();
-            if(Handle::UNDEFINED != target and
-               (not nameserver().isA(target->get_type(), HEBBIAN_LINK))){
-                Handle link = _as->get_handle(ASYMMETRIC_HEBBIAN_LINK, source, target);
-                if (link == Handle::UNDEFINED)
-                    addHebbian(source,target);
-            }
+        //Pick random targets and create the links if they don't exist already
+        for (const Handle& target : _bank->getRandomAtomsNotInAF(farLinks)) {
+            if (nameserver().isA(target->get_type(), HEBBIAN_LINK)) continue;
+            if (targets.count(target)) continue;
+            missing.emplace(src, target);
         }
-    //Check the ammount of HebbianLinks the Atom has
-    IncomingSet iset;
-    nameserver().foreachRecursive(
-        [&] (Type type)->void {
-            IncomingSet ts = source->getIncomingSetByType(type);
-            iset.insert(iset.end(), ts.begin(), ts.end());
-        },
-        HEBBIAN_LINK);
-
-    //If it is more then the allowed max delete some randomly.
-    //TODO: find a simple rule to decide which atoms to forget
-    //      that will keep some of the weak links intact
-    if (iset.size() >= maxLinkNum) {
-        std::uniform_int_distribution<int> distribution2(0,iset.size()-1);
-        std::default_random_engine generator;
-        size_t s = iset.size();
-        do {
-            _as->remove_atom(iset[distribution2(generator)]->get_handle(), true);
-            s--;
-        } while (s >= maxLinkNum);
+
+        if (_budget.exhausted()) break;
     }
-}
 
-void HebbianCreationAgent::addHebbian(Handle source,Handle target)
-{
-    Handle link = _as->add_link(ASYMMETRIC_HEBBIAN_LINK, source, target);
-    link->setValue(truth_key(), SimpleTruthValue::createTV(0.5, 0.1));
-    _bank->inc_vlti(link);
+    if (not _pending.empty()) _budget.defer();
+
+    store.add(missing, 0.5, 0.1);
+
+    //If the Atom has more HebbianLinks than allowed, drop the weakest
+    //ones, so that the strong links survive.
+    for (const Handle& src : sources)
+        store.limit_degree(src, maxLinkNum);
 }
@@ -23,6 +23,7 @@
 #ifndef _OPENCOG_HEBBIAN_CREATION_AGENT_H
 #define _OPENCOG_HEBBIAN_CREATION_AGENT_H
 
+#include <deque>
 #include <string>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -30,7 +31,11 @@
 #include <opencog/attentionbank/bank/AttentionBank.h>
 #include <opencog/cogserver/modules/agents/Agent.h>
 
+#include "AgentBudget.h"
 #include "AttentionParamQuery.h"
+#include "HebbianStore.h"
+
+class HebbianCreationModuleUTest;
 
 namespace opencog
 {
@@ -46,22 +51,40 @@ namespace opencog
  * If will also create links to Atoms outside the Focus. The localToFarLinks
  * parameter decides how many of these "far" Links should be created.
  *
- * If after creating these Links the Atom has to many outgoing HebbianLinks
- * this agent will delete Links randomly until the number of links is less then
- * the maxLinkNum.
+ * If after creating these Links the Atom has to many HebbianLinks this agent
+ * will delete its weakest Links, by truth value mean, until the number of
+ * links is less then the maxLinkNum. The hebbian store keeps track of the
+ * links of each atom, so this does not need the incoming set.
  *
  * This Agents is supposed to run in it's own Thread and gets Atoms that enter
  * the Focus via a shared queue  (newAtomsInAV) from the AttentionModule.
+ * Each run takes all the Atoms waiting in the queue, works out the missing
+ * links for all of them against one snapshot of the Focus, and creates
+ * them together. When AGENT_RUN_BUDGET is set, a run stops taking atoms
+ * once the budget is spent, and the rest wait for the next run.
+ *
+ * The links are made through the current HebbianStore. With
+ * HEBBIAN_DENSE_STORE set, links between Focus atoms are matrix entries
+ * and only count towards maxLinkNum once they are written back.
  */
 class HebbianCreationAgent : public Agent
 {
 private:
+    friend class ::HebbianCreationModuleUTest;
+
     AttentionParamQuery _atq;
+    std::shared_ptr<HebbianStoreSelector> _stores;
+
+    AgentBudget _budget;
+
+    // Atoms that entered the Focus and still need their links.
+    std::deque<Handle> _pending;
+
+    void createHebbians(HebbianStore&);
 
 protected:
     AttentionBank* _bank;
 
-    void addHebbian(Handle atom, Handle source);
     double targetConjunction(Handle handle1, Handle handle2);
 
     unsigned int maxLinkNum;
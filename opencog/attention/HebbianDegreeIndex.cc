@@ -0,0 +1,154 @@
+/*
+ * opencog/attention/HebbianDegreeIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <functional>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include "HebbianDegreeIndex.h"
+
+using namespace opencog;
+using namespace std::placeholders;
+
+HebbianDegreeIndex::HebbianDegreeIndex(AtomSpace* as) : _as(as)
+{
+    _addConnection = _as->atomAddedSignal().connect(
+            std::bind(&HebbianDegreeIndex::atomAddedHandler, this, _1));
+    _removeConnection = _as->atomRemovedSignal().connect(
+            std::bind(&HebbianDegreeIndex::atomRemovedHandler, this, _1));
+    _tvConnection = _as->TVChangedSignal().connect(
+            std::bind(&HebbianDegreeIndex::TVChangedHandler, this, _1, _2, _3));
+
+    HandleSeq links;
+    _as->get_handles_by_type(links, HEBBIAN_LINK, true);
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    for (const Handle& h : links)
+        insertLink(h);
+}
+
+HebbianDegreeIndex::~HebbianDegreeIndex()
+{
+    _as->atomAddedSignal().disconnect(_addConnection);
+    _as->atomRemovedSignal().disconnect(_removeConnection);
+    _as->TVChangedSignal().disconnect(_tvConnection);
+}
+
+/*
+ * Both insertLink and removeLink expect the caller to hold _mtx.
+ */
+void HebbianDegreeIndex::insertLink(const Handle& link)
+{
+    if (not _strength.emplace(link, 0).second) return;
+
+    double strength = link->getTruthValue()->get_mean();
+    _strength[link] = strength;
+
+    const HandleSeq& outgoing = link->getOutgoingSet();
+    for (size_t i = 0; i < outgoing.size(); i++) {
+        Entry& e = _entries[outgoing[i]];
+        if (0 == i) e.out++;
+        else e.in++;
+        e.links.emplace(strength, link);
+    }
+}
+
+void HebbianDegreeIndex::removeLink(const Handle& link)
+{
+    auto it = _strength.find(link);
+    if (it == _strength.end()) return;
+    double strength = it->second;
+    _strength.erase(it);
+
+    const HandleSeq& outgoing = link->getOutgoingSet();
+    for (size_t i = 0; i < outgoing.size(); i++) {
+        auto eit = _entries.find(outgoing[i]);
+        if (eit == _entries.end()) continue;
+
+        Entry& e = eit->second;
+        if (0 == i) e.out--;
+        else e.in--;
+        e.links.erase({strength, link});
+        if (e.links.empty()) _entries.erase(eit);
+    }
+}
+
+void HebbianDegreeIndex::atomAddedHandler(const Handle& h)
+{
+    if (not nameserver().isA(h->get_type(), HEBBIAN_LINK)) return;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    insertLink(h);
+}
+
+void HebbianDegreeIndex::atomRemovedHandler(const AtomPtr& atom)
+{
+    Handle h(atom);
+    if (not nameserver().isA(h->get_type(), HEBBIAN_LINK)) return;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    removeLink(h);
+}
+
+/*
+ * Re-queue the link under its new strength.
+ */
+void HebbianDegreeIndex::TVChangedHandler(const Handle& h,
+                                          const TruthValuePtr& old_tv,
+                                          const TruthValuePtr& new_tv)
+{
+    if (not nameserver().isA(h->get_type(), HEBBIAN_LINK)) return;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    removeLink(h);
+    insertLink(h);
+}
+
+size_t HebbianDegreeIndex::in_degree(const Handle& h) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _entries.find(h);
+    return it == _entries.end() ? 0 : it->second.in;
+}
+
+size_t HebbianDegreeIndex::out_degree(const Handle& h) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _entries.find(h);
+    return it == _entries.end() ? 0 : it->second.out;
+}
+
+size_t HebbianDegreeIndex::degree(const Handle& h) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _entries.find(h);
+    return it == _entries.end() ? 0 : it->second.links.size();
+}
+
+Handle HebbianDegreeIndex::weakest(const Handle& h) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _entries.find(h);
+    if (it == _entries.end()) return Handle::UNDEFINED;
+    return it->second.links.begin()->second;
+}
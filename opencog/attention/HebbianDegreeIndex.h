@@ -0,0 +1,95 @@
+/*
+ * opencog/attention/HebbianDegreeIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_HEBBIAN_DEGREE_INDEX_H
+#define _OPENCOG_HEBBIAN_DEGREE_INDEX_H
+
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/**
+ * Keeps, for every atom, the number of hebbian links it takes part in,
+ * and those links ordered by the mean of their truth value, so that the
+ * weakest can be found without fetching the incoming set.
+ *
+ * The first atom of a hebbian link counts it as outgoing, the second as
+ * incoming. The index follows the AtomSpace add, remove and TV changed
+ * signals, and is built from the existing hebbian links on construction.
+ * Updates and lookups are O(log d) in the degree of the atom.
+ */
+class HebbianDegreeIndex
+{
+private:
+    typedef std::set<std::pair<double, Handle>> LinkQueue;
+
+    struct Entry {
+        size_t in = 0;
+        size_t out = 0;
+        LinkQueue links;
+    };
+
+    AtomSpace* _as;
+
+    mutable std::mutex _mtx;
+    std::unordered_map<Handle, Entry> _entries;
+    std::unordered_map<Handle, double> _strength;
+
+    int _addConnection;
+    int _removeConnection;
+    int _tvConnection;
+
+    void insertLink(const Handle&);
+    void removeLink(const Handle&);
+
+    void atomAddedHandler(const Handle&);
+    void atomRemovedHandler(const AtomPtr&);
+    void TVChangedHandler(const Handle&, const TruthValuePtr&,
+                          const TruthValuePtr&);
+
+public:
+    HebbianDegreeIndex(AtomSpace*);
+    ~HebbianDegreeIndex();
+
+    size_t in_degree(const Handle&) const;
+    size_t out_degree(const Handle&) const;
+
+    /// Number of hebbian links the atom takes part in.
+    size_t degree(const Handle&) const;
+
+    /// The atom's hebbian link with the lowest mean, or the undefined
+    /// handle if it has none.
+    Handle weakest(const Handle&) const;
+};
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_HEBBIAN_DEGREE_INDEX_H
@@ -0,0 +1,394 @@
+/*
+ * opencog/attention/HebbianGraph.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include "HebbianGraph.h"
+
+using namespace opencog;
+using namespace std::placeholders;
+
+HebbianGraph::HebbianGraph(AtomSpace* as) :
+    _as(as), _links(as), _edges(0)
+{
+    _removeConnection = _as->atomRemovedSignal().connect(
+            std::bind(&HebbianGraph::atomRemovedHandler, this, _1));
+
+    HandleSeq links;
+    _as->get_handles_by_type(links, ASYMMETRIC_HEBBIAN_LINK);
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    for (const Handle& link : links) {
+        if (2 != link->get_arity()) continue;
+        TruthValuePtr tv = link->getTruthValue();
+        uint32_t from = id(link->getOutgoingAtom(0));
+        insert(from, id(link->getOutgoingAtom(1)),
+               tv->get_mean(), tv->get_confidence());
+    }
+}
+
+HebbianGraph::~HebbianGraph()
+{
+    _as->atomRemovedSignal().disconnect(_removeConnection);
+
+    std::vector<Edge> edges;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        edges.reserve(_edges);
+        for (uint32_t n = 0; n < _nodes.size(); n++)
+            for (const Arc& a : _out[n])
+                edges.push_back({_nodes[n], _nodes[a.node],
+                                 a.strength, a.confidence});
+    }
+    _links.put(edges);
+}
+
+/*
+ * The helpers below expect the caller to hold _mtx.
+ */
+uint32_t HebbianGraph::id(const Handle& h)
+{
+    auto it = _ids.find(h);
+    if (it != _ids.end()) return it->second;
+
+    uint32_t n;
+    if (_free.empty()) {
+        n = _nodes.size();
+        _nodes.push_back(h);
+        _out.emplace_back();
+        _in.emplace_back();
+    } else {
+        n = _free.back();
+        _free.pop_back();
+        _nodes[n] = h;
+    }
+    _ids[h] = n;
+    return n;
+}
+
+bool HebbianGraph::lookup(const Handle& h, uint32_t& n) const
+{
+    auto it = _ids.find(h);
+    if (it == _ids.end()) return false;
+    n = it->second;
+    return true;
+}
+
+HebbianGraph::Arc* HebbianGraph::find(uint32_t from, uint32_t to)
+{
+    for (Arc& a : _out[from])
+        if (a.node == to) return &a;
+    return nullptr;
+}
+
+void HebbianGraph::insert(uint32_t from, uint32_t to,
+                          float strength, float confidence)
+{
+    Arc* arc = find(from, to);
+    if (arc) {
+        arc->strength = strength;
+        arc->confidence = confidence;
+        return;
+    }
+    _out[from].push_back({to, strength, confidence});
+    _in[to].push_back(from);
+    _edges++;
+}
+
+// Arcs are unordered, so they are removed by moving the last one into
+// their place.
+template<typename T, typename Pred>
+static void unordered_erase(std::vector<T>& v, Pred pred)
+{
+    auto it = std::find_if(v.begin(), v.end(), pred);
+    if (it == v.end()) return;
+    *it = v.back();
+    v.pop_back();
+}
+
+void HebbianGraph::erase(uint32_t from, uint32_t to)
+{
+    unordered_erase(_out[from], [to](const Arc& a) { return a.node == to; });
+    unordered_erase(_in[to], [from](uint32_t n) { return n == from; });
+    _edges--;
+}
+
+void HebbianGraph::drop(uint32_t n)
+{
+    while (not _out[n].empty())
+        erase(n, _out[n].back().node);
+    while (not _in[n].empty())
+        erase(_in[n].back(), n);
+
+    Arcs().swap(_out[n]);
+    std::vector<uint32_t>().swap(_in[n]);
+    _ids.erase(_nodes[n]);
+    _nodes[n] = Handle::UNDEFINED;
+    _free.push_back(n);
+}
+
+/*
+ * A removed link takes its edge along, unless take_links() is moving
+ * the edge out of the AtomSpace.
+ */
+void HebbianGraph::atomRemovedHandler(const AtomPtr& atom)
+{
+    Handle h(atom);
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    if (h->get_type() == ASYMMETRIC_HEBBIAN_LINK and 2 == h->get_arity())
+    {
+        if (0 < _taken.erase(h)) return;
+        uint32_t from, to;
+        if (lookup(h->getOutgoingAtom(0), from) and
+            lookup(h->getOutgoingAtom(1), to) and
+            nullptr != find(from, to))
+        {
+            erase(from, to);
+            changed();
+        }
+        return;
+    }
+
+    uint32_t n;
+    if (not lookup(h, n)) return;
+    drop(n);
+    changed();
+}
+
+void HebbianGraph::add(const std::set<std::pair<Handle, Handle>>& pairs,
+                       strength_t strength, confidence_t confidence)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    changed();
+    for (const auto& p : pairs) {
+        uint32_t from = id(p.first);
+        uint32_t to = id(p.second);
+        if (nullptr == find(from, to))
+            insert(from, to, strength, confidence);
+    }
+}
+
+HebbianStore::Row HebbianGraph::row(const Handle& source)
+{
+    Row result;
+    std::lock_guard<std::mutex> lock(_mtx);
+    uint32_t from;
+    if (not lookup(source, from)) return result;
+
+    result.reserve(_out[from].size());
+    for (const Arc& a : _out[from])
+        result.push_back({_nodes[a.node], a.strength, a.confidence});
+    return result;
+}
+
+void HebbianGraph::set_row(const Handle& source, const Row& row)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    uint32_t from;
+    if (not lookup(source, from)) return;
+    changed();
+
+    // Position of each target in the source's array.
+    Arcs& arcs = _out[from];
+    std::unordered_map<uint32_t, size_t> position;
+    for (size_t i = 0; i < arcs.size(); i++)
+        position[arcs[i].node] = i;
+
+    for (const Weight& w : row) {
+        uint32_t to;
+        if (not lookup(w.target, to)) continue;
+        auto it = position.find(to);
+        if (it == position.end()) continue;
+        arcs[it->second].strength = w.strength;
+        arcs[it->second].confidence = w.confidence;
+    }
+}
+
+void HebbianGraph::put(const std::vector<Edge>& edges)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (not edges.empty()) changed();
+    for (const Edge& e : edges) {
+        // Either atom may have been removed from the AtomSpace since.
+        if (nullptr == e.source->getAtomSpace() or
+            nullptr == e.target->getAtomSpace())
+            continue;
+        uint32_t from = id(e.source);
+        insert(from, id(e.target), e.strength, e.confidence);
+    }
+}
+
+HebbianStore::Row HebbianGraph::column(const Handle& target)
+{
+    Row result;
+    std::lock_guard<std::mutex> lock(_mtx);
+    uint32_t to;
+    if (not lookup(target, to)) return result;
+
+    result.reserve(_in[to].size());
+    for (uint32_t from : _in[to]) {
+        const Arc* a = find(from, to);
+        result.push_back({_nodes[from], a->strength, a->confidence});
+    }
+    return result;
+}
+
+HandleSeq HebbianGraph::sources(const Handle& target)
+{
+    HandleSeq result;
+    std::lock_guard<std::mutex> lock(_mtx);
+    uint32_t to;
+    if (not lookup(target, to)) return result;
+
+    result.reserve(_in[to].size());
+    for (uint32_t from : _in[to])
+        result.push_back(_nodes[from]);
+    return result;
+}
+
+/*
+ * Removes the arc, in or out, with the lowest strength, until the atom
+ * takes part in fewer than maxLinks.
+ */
+void HebbianGraph::limit_degree(const Handle& atom, size_t maxLinks)
+{
+    std::vector<std::pair<Handle, Handle>> erased;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        uint32_t n;
+        if (not lookup(atom, n)) return;
+
+        while (0 < _out[n].size() + _in[n].size() and
+               _out[n].size() + _in[n].size() >= maxLinks)
+        {
+            uint32_t from = n, to = n;
+            float weakest = 0;
+            bool found = false;
+            for (const Arc& a : _out[n]) {
+                if (found and weakest <= a.strength) continue;
+                weakest = a.strength;
+                to = a.node;
+                found = true;
+            }
+            for (uint32_t src : _in[n]) {
+                float strength = find(src, n)->strength;
+                if (found and weakest <= strength) continue;
+                weakest = strength;
+                from = src;
+                to = n;
+                found = true;
+            }
+            erased.emplace_back(_nodes[from], _nodes[to]);
+            erase(from, to);
+        }
+        if (not erased.empty()) changed();
+    }
+
+    // An edge that also has a link loses it too, or the next graph
+    // would load the edge again. Removing the link calls back into
+    // atomRemovedHandler, so this is done without the lock.
+    for (const auto& e : erased) {
+        Handle link = _as->get_handle(ASYMMETRIC_HEBBIAN_LINK,
+                                      e.first, e.second);
+        if (link) _as->remove_atom(link);
+    }
+}
+
+Handle HebbianGraph::link(const Handle& source, const Handle& target)
+{
+    Edge edge;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        uint32_t from, to;
+        if (not lookup(source, from) or not lookup(target, to))
+            return Handle::UNDEFINED;
+        const Arc* a = find(from, to);
+        if (nullptr == a) return Handle::UNDEFINED;
+        edge = {source, target, a->strength, a->confidence};
+    }
+    _links.put({edge});
+    return _as->get_handle(ASYMMETRIC_HEBBIAN_LINK, source, target);
+}
+
+/*
+ * Only links that match an edge go; others, made after the graph was
+ * built, are left alone.
+ */
+size_t HebbianGraph::take_links()
+{
+    HandleSeq links;
+    _as->get_handles_by_type(links, ASYMMETRIC_HEBBIAN_LINK);
+
+    HandleSeq held;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        for (const Handle& link : links) {
+            if (2 != link->get_arity()) continue;
+            uint32_t from, to;
+            if (lookup(link->getOutgoingAtom(0), from) and
+                lookup(link->getOutgoingAtom(1), to) and
+                nullptr != find(from, to))
+            {
+                held.push_back(link);
+                _taken.insert(link);
+            }
+        }
+    }
+
+    size_t removed = 0;
+    for (const Handle& link : held)
+        if (_as->remove_atom(link)) removed++;
+
+    // Links that could not be removed never reached the handler.
+    std::lock_guard<std::mutex> lock(_mtx);
+    _taken.clear();
+    return removed;
+}
+
+size_t HebbianGraph::size() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _edges;
+}
+
+/*
+ * Counts the arrays by their capacity, and each entry of the id map as
+ * a hash node with a bucket pointer.
+ */
+size_t HebbianGraph::bytes() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    size_t total = _nodes.capacity() * sizeof(Handle)
+                 + _out.capacity() * sizeof(Arcs)
+                 + _in.capacity() * sizeof(std::vector<uint32_t>)
+                 + _free.capacity() * sizeof(uint32_t)
+                 + _ids.size() * (sizeof(std::pair<Handle, uint32_t>) + 2 * sizeof(void*))
+                 + _ids.bucket_count() * sizeof(void*);
+    for (uint32_t n = 0; n < _nodes.size(); n++)
+        total += _out[n].capacity() * sizeof(Arc)
+               + _in[n].capacity() * sizeof(uint32_t);
+    return total;
+}
@@ -0,0 +1,133 @@
+/*
+ * opencog/attention/HebbianGraph.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_HEBBIAN_GRAPH_H
+#define _OPENCOG_HEBBIAN_GRAPH_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "HebbianStore.h"
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/**
+ * A hebbian store that keeps the links outside the AtomSpace, as a
+ * graph of adjacency arrays with float weights.
+ *
+ * Every atom with a hebbian link gets a node id. A node holds an array
+ * of its outgoing arcs, each the target id with the strength and
+ * confidence, and an array of the ids of its sources. An edge costs
+ * about 16 bytes, against the several hundred of a link atom with its
+ * TV and its entries in two incoming sets, and a neighbour scan reads
+ * one contiguous array instead of filtering an incoming set.
+ *
+ * On construction the AsymmetricHebbianLinks already in the AtomSpace
+ * are loaded into the graph. They stay in the AtomSpace until
+ * take_links() removes them; the memory saving only comes then. The
+ * HebbianStoreSelector does so as soon as it makes a graph. The
+ * AtomSpace remains the record that outlives the graph: an edge that
+ * the graph drops takes its link along, and on destruction all the
+ * edges are written back as links.
+ *
+ * In between, get_target_neighbors() and get_source_neighbors() ask
+ * the current store for hebbian neighbours, and link() gives the
+ * AtomSpace atom of an edge to queries that need one. The edges of an
+ * atom are dropped when it is removed from the AtomSpace, and so is
+ * the edge of a link removed by anything but take_links().
+ */
+class HebbianGraph : public HebbianStore
+{
+private:
+    struct Arc {
+        uint32_t node;
+        float strength;
+        float confidence;
+    };
+    typedef std::vector<Arc> Arcs;
+
+    AtomSpace* _as;
+    AtomSpaceHebbianStore _links;
+
+    mutable std::mutex _mtx;
+    HandleSeq _nodes;                        // Atom of each node id
+    std::unordered_map<Handle, uint32_t> _ids;
+    std::vector<Arcs> _out;
+    std::vector<std::vector<uint32_t>> _in;  // Sources of the arcs in
+    std::vector<uint32_t> _free;
+    size_t _edges;
+
+    // Links being removed by take_links(), whose edges stay.
+    UnorderedHandleSet _taken;
+
+    int _removeConnection;
+
+    uint32_t id(const Handle&);
+    bool lookup(const Handle&, uint32_t&) const;
+    Arc* find(uint32_t from, uint32_t to);
+    void insert(uint32_t from, uint32_t to, float strength, float confidence);
+    void erase(uint32_t from, uint32_t to);
+    void drop(uint32_t);
+
+    void atomRemovedHandler(const AtomPtr&);
+
+public:
+    HebbianGraph(AtomSpace*);
+    ~HebbianGraph();
+
+    void add(const std::set<std::pair<Handle, Handle>>&,
+             strength_t, confidence_t);
+    Row row(const Handle& source);
+    void set_row(const Handle& source, const Row&);
+    void put(const std::vector<Edge>&);
+    Row column(const Handle& target);
+    HandleSeq sources(const Handle& target);
+    void limit_degree(const Handle&, size_t maxLinks);
+
+    /// The edge as an AsymmetricHebbianLink, with its weight as TV. The
+    /// link is added to the AtomSpace, if need be. Returns the undefined
+    /// handle if there is no such edge.
+    Handle link(const Handle& source, const Handle& target);
+
+    /// Removes from the AtomSpace the links of the edges held by the
+    /// graph, unless something else refers to them, so that they live
+    /// in the graph only until it writes them back on destruction.
+    /// Returns the number of links removed.
+    size_t take_links();
+
+    /// Number of edges.
+    size_t size() const;
+
+    /// Memory held by the graph, in bytes.
+    size_t bytes() const;
+};
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_HEBBIAN_GRAPH_H
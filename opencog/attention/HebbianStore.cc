@@ -0,0 +1,255 @@
+/*
+ * opencog/attention/HebbianStore.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/bank/AVUtils.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include "AFHebbianMatrix.h"
+#include "HebbianDegreeIndex.h"
+#include "HebbianGraph.h"
+#include "HebbianStore.h"
+
+using namespace opencog;
+
+AtomSpaceHebbianStore::AtomSpaceHebbianStore(AtomSpace* as) :
+    _as(as), _bank(&attentionbank(as))
+{
+}
+
+AtomSpaceHebbianStore::~AtomSpaceHebbianStore()
+{
+}
+
+/*
+ * New links get their VLTI raised, so that they are not forgotten right
+ * away. This is done in a single bank update.
+ */
+void AtomSpaceHebbianStore::raiseVLTI(const HandleSeq& links)
+{
+    std::vector<AttentionValuePtr> avs;
+    avs.reserve(links.size());
+    for (const Handle& link : links) {
+        AttentionValuePtr av = get_av(link);
+        avs.push_back(AttentionValue::createAV(
+            av->getSTI(), av->getLTI(), av->getVLTI() + 1));
+    }
+    _bank->change_av(links, avs);
+}
+
+void AtomSpaceHebbianStore::add(
+        const std::set<std::pair<Handle, Handle>>& pairs,
+        strength_t strength, confidence_t confidence)
+{
+    TruthValuePtr tv = SimpleTruthValue::createTV(strength, confidence);
+
+    HandleSeq links;
+    links.reserve(pairs.size());
+    for (const auto& p : pairs) {
+        if (_as->get_handle(ASYMMETRIC_HEBBIAN_LINK, p.first, p.second))
+            continue;
+        Handle link = _as->add_link(ASYMMETRIC_HEBBIAN_LINK, p.first, p.second);
+        link->setTruthValue(tv);
+        links.push_back(link);
+    }
+    if (not links.empty()) changed();
+    raiseVLTI(links);
+}
+
+void AtomSpaceHebbianStore::put(const std::vector<Edge>& edges)
+{
+    if (edges.empty()) return;
+    changed();
+
+    HandleSeq created;
+    for (const Edge& e : edges) {
+        // Either atom may have been removed from the AtomSpace since.
+        if (nullptr == e.source->getAtomSpace() or
+            nullptr == e.target->getAtomSpace())
+            continue;
+
+        Handle link = _as->get_handle(ASYMMETRIC_HEBBIAN_LINK,
+                                      e.source, e.target);
+        if (nullptr == link) {
+            link = _as->add_link(ASYMMETRIC_HEBBIAN_LINK, e.source, e.target);
+            created.push_back(link);
+        }
+        link->setTruthValue(
+            SimpleTruthValue::createTV(e.strength, e.confidence));
+    }
+    raiseVLTI(created);
+}
+
+HebbianStore::Row AtomSpaceHebbianStore::row(const Handle& source)
+{
+    Row result;
+    for (const Handle& link :
+         source->getIncomingSetByType(ASYMMETRIC_HEBBIAN_LINK))
+    {
+        if (link->getOutgoingAtom(0) != source) continue;
+        TruthValuePtr tv = link->getTruthValue();
+        result.push_back({link->getOutgoingAtom(1),
+                          tv->get_mean(), tv->get_confidence()});
+    }
+    return result;
+}
+
+/*
+ * Walks the incoming set of the source once, rather than looking up the
+ * link to every target.
+ */
+void AtomSpaceHebbianStore::set_row(const Handle& source, const Row& row)
+{
+    if (row.empty()) return;
+    changed();
+
+    std::unordered_map<Handle, const Weight*> weights;
+    for (const Weight& w : row)
+        weights[w.target] = &w;
+
+    for (const Handle& link :
+         source->getIncomingSetByType(ASYMMETRIC_HEBBIAN_LINK))
+    {
+        if (link->getOutgoingAtom(0) != source) continue;
+        auto it = weights.find(link->getOutgoingAtom(1));
+        if (it == weights.end()) continue;
+        link->setTruthValue(SimpleTruthValue::createTV(
+            it->second->strength, it->second->confidence));
+    }
+}
+
+HebbianStore::Row AtomSpaceHebbianStore::column(const Handle& target)
+{
+    Row result;
+    for (const Handle& link :
+         target->getIncomingSetByType(ASYMMETRIC_HEBBIAN_LINK))
+    {
+        if (link->getOutgoingAtom(1) != target) continue;
+        TruthValuePtr tv = link->getTruthValue();
+        result.push_back({link->getOutgoingAtom(0),
+                          tv->get_mean(), tv->get_confidence()});
+    }
+    return result;
+}
+
+HandleSeq AtomSpaceHebbianStore::sources(const Handle& target)
+{
+    HandleSeq result;
+    for (const Handle& link :
+         target->getIncomingSetByType(ASYMMETRIC_HEBBIAN_LINK))
+    {
+        if (link->getOutgoingAtom(1) != target) continue;
+        result.push_back(link->getOutgoingAtom(0));
+    }
+    return result;
+}
+
+void AtomSpaceHebbianStore::limit_degree(const Handle& atom, size_t maxLinks)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        if (nullptr == _degreeIndex)
+            _degreeIndex.reset(new HebbianDegreeIndex(_as));
+    }
+
+    while (_degreeIndex->degree(atom) >= maxLinks) {
+        Handle weakest = _degreeIndex->weakest(atom);
+        if (Handle::UNDEFINED == weakest or
+            not _as->remove_atom(weakest, true))
+            break;
+        changed();
+    }
+}
+
+HebbianStoreSelector::HebbianStoreSelector(AtomSpace* as) :
+    _as(as), _version(0), _dense(false), _graph(false)
+{
+}
+
+HebbianStorePtr HebbianStoreSelector::get(const EcanParams& params)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (nullptr != _store and _version == params.version)
+        return _store;
+    _version = params.version;
+
+    bool dense = params.heb_dense_store;
+    bool graph = params.heb_graph_store;
+    if (nullptr != _store and _dense == dense and _graph == graph)
+    {
+        auto matrix = std::dynamic_pointer_cast<AFHebbianMatrix>(_store);
+        if (matrix)
+            matrix->set_persist_threshold(params.heb_persist_threshold);
+        return _store;
+    }
+
+    // Let go of the old store first, so that, unless an agent is still
+    // using it, its weights are back in the AtomSpace before the new one
+    // loads them.
+    _store.reset();
+
+    HebbianStorePtr links;
+    if (graph) {
+        // The links move into the graph, which is what saves memory.
+        auto g = std::make_shared<HebbianGraph>(_as);
+        g->take_links();
+        links = g;
+    } else {
+        links = std::make_shared<AtomSpaceHebbianStore>(_as);
+    }
+
+    if (dense) {
+        auto matrix = std::make_shared<AFHebbianMatrix>(_as, links);
+        matrix->set_persist_threshold(params.heb_persist_threshold);
+        _store = matrix;
+    } else {
+        _store = links;
+    }
+    _dense = dense;
+    _graph = graph;
+    return _store;
+}
+
+HebbianStorePtr HebbianStoreSelector::current(void)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _store;
+}
+
+std::shared_ptr<HebbianStoreSelector> opencog::hebbian_store_selector(AtomSpace* as)
+{
+    static std::mutex _mtx;
+    static std::map<AtomSpace*, std::weak_ptr<HebbianStoreSelector>> _selectors;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    std::shared_ptr<HebbianStoreSelector> sel = _selectors[as].lock();
+    if (nullptr == sel) {
+        sel = std::make_shared<HebbianStoreSelector>(as);
+        _selectors[as] = sel;
+    }
+    return sel;
+}
@@ -0,0 +1,196 @@
+/*
+ * opencog/attention/HebbianStore.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_HEBBIAN_STORE_H
+#define _OPENCOG_HEBBIAN_STORE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include <opencog/atoms/truthvalue/TruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "EcanParams.h"
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+class AttentionBank;
+class HebbianDegreeIndex;
+
+/**
+ * Where the hebbian agents and the diffusion agents keep and look up the
+ * weights of asymmetric hebbian links.
+ *
+ * A weight is the strength and confidence of the link from a source atom
+ * to a target atom. Weights are read and written a row at a time, that
+ * is, all the outgoing links of one source together.
+ */
+class HebbianStore
+{
+public:
+    struct Weight {
+        Handle target;
+        strength_t strength;
+        confidence_t confidence;
+    };
+    typedef std::vector<Weight> Row;
+    typedef std::vector<std::pair<Handle, Row>> Rows;
+
+    struct Edge {
+        Handle source;
+        Handle target;
+        strength_t strength;
+        confidence_t confidence;
+    };
+
+    virtual ~HebbianStore() {}
+
+    /// Creates the links from first to second that do not exist yet, all
+    /// with the given strength and confidence.
+    virtual void add(const std::set<std::pair<Handle, Handle>>&,
+                     strength_t, confidence_t) = 0;
+
+    /// The weights of all the links out of the source.
+    virtual Row row(const Handle& source) = 0;
+
+    /// Sets the weights of existing links out of the source. Targets
+    /// that the source has no link to are skipped.
+    virtual void set_row(const Handle& source, const Row&) = 0;
+
+    /// Sets the rows of several sources at once.
+    virtual void set_rows(const Rows& rows)
+    {
+        for (const auto& r : rows)
+            set_row(r.first, r.second);
+    }
+
+    /// Creates the links, or sets their weights if they exist.
+    virtual void put(const std::vector<Edge>&) = 0;
+
+    /// The weights of all the links into the target. Each weight holds
+    /// the source of its link in the target field.
+    virtual Row column(const Handle& target) = 0;
+
+    /// The atoms that have a link to the target.
+    virtual HandleSeq sources(const Handle& target) = 0;
+
+    /// Removes the weakest links of the atom, in either direction, until
+    /// it takes part in fewer than maxLinks.
+    virtual void limit_degree(const Handle&, size_t maxLinks) = 0;
+
+    /// Writes any weights held back by the store to the AtomSpace.
+    virtual void flush() {}
+
+    /// Goes up whenever a weight is written or a link is made or
+    /// dropped, so that a reader can tell whether the rows it read
+    /// earlier may have changed.
+    virtual unsigned long version() const { return _version; }
+
+protected:
+    std::atomic<unsigned long> _version{0};
+
+    void changed() { _version++; }
+};
+
+typedef std::shared_ptr<HebbianStore> HebbianStorePtr;
+
+/**
+ * The default store: every weight is the TV of an AsymmetricHebbianLink.
+ * The degrees used by limit_degree are tracked by a HebbianDegreeIndex,
+ * built on first use.
+ */
+class AtomSpaceHebbianStore : public HebbianStore
+{
+private:
+    AtomSpace* _as;
+    AttentionBank* _bank;
+
+    std::mutex _mtx; // Guards the creation of _degreeIndex
+    std::unique_ptr<HebbianDegreeIndex> _degreeIndex;
+
+    void raiseVLTI(const HandleSeq&);
+
+public:
+    AtomSpaceHebbianStore(AtomSpace*);
+    ~AtomSpaceHebbianStore();
+
+    void add(const std::set<std::pair<Handle, Handle>>&,
+             strength_t, confidence_t);
+    Row row(const Handle& source);
+    void set_row(const Handle& source, const Row&);
+    void put(const std::vector<Edge>&);
+    Row column(const Handle& target);
+    HandleSeq sources(const Handle& target);
+    void limit_degree(const Handle&, size_t maxLinks);
+};
+
+/**
+ * Keeps the hebbian store of one AtomSpace, and chooses it from the ECAN
+ * params. The links live in a HebbianGraph if HEBBIAN_GRAPH_STORE is
+ * set, which takes them out of the AtomSpace, and as AtomSpace links
+ * otherwise; with HEBBIAN_DENSE_STORE set,
+ * those between AF atoms are held in an AFHebbianMatrix in front of
+ * either. HEBBIAN_PERSIST_THRESHOLD is the strength at which the matrix
+ * writes a weight through while its atoms are still in the AF.
+ *
+ * The params are only looked at when their version changes, and the
+ * store is only replaced when the kind of store asked for changes. Agents
+ * hold on to the store they got for a whole cycle, so a replaced store
+ * lives on until they are done with it, and then writes all its weights
+ * back as links.
+ */
+class HebbianStoreSelector
+{
+private:
+    AtomSpace* _as;
+    std::mutex _mtx;
+    HebbianStorePtr _store;
+    unsigned long _version;
+    bool _dense;
+    bool _graph;
+
+public:
+    HebbianStoreSelector(AtomSpace*);
+
+    /// The store to use with the given params.
+    HebbianStorePtr get(const EcanParams&);
+
+    /// The store last handed out, or null if there is none yet.
+    HebbianStorePtr current(void);
+};
+
+/// Returns the store selector of the given AtomSpace, creating it if
+/// there is none. It is shared by all callers, and lives, with its
+/// store, as long as any of them holds it.
+std::shared_ptr<HebbianStoreSelector> hebbian_store_selector(AtomSpace*);
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_HEBBIAN_STORE_H
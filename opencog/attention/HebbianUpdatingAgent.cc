@@ -21,8 +21,11 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <math.h>
 #include <time.h>
+#include <unordered_map>
+#include <vector>
 
 #include <opencog/util/Config.h>
 #include <opencog/util/mt19937ar.h>
@@ -32,8 +35,10 @@
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/bank/AVUtils.h>
 #include <opencog/atoms/truthvalue/SimpleTruthValue.h>
 
+#include "HebbianStore.h"
 #include "HebbianUpdatingAgent.h"
 #include "Neighbors.h"
 
@@ -41,98 +46,136 @@
 
 using namespace opencog;
 
+// Number of sources updated between checks of the budget.
+static const size_t UPDATE_CHUNK = 64;
+
 HebbianUpdatingAgent::HebbianUpdatingAgent(CogServer& cs) :
-        Agent(cs)
+        Agent(cs), _atq(&cs.getAtomSpace()), _budget(info().id), _cursor(0)
 {
     _bank = &attentionbank(_as);
+    _stores = hebbian_store_selector(_as);
     // Provide a logger
     setLogger(new opencog::Logger("HebbianUpdatingAgent.log", Logger::FINE, true));
 }
 
 void HebbianUpdatingAgent::run()
 {
-    HandleSeq atoms;
-    size_t size;
-
-    std::back_insert_iterator<HandleSeq> out_hi(atoms);
-
-    _bank->get_handle_set_in_attentional_focus(out_hi);
-
-    size = atoms.size();
-
-    if (size == 0)
-        return;
-
-    std::default_random_engine generator;
-    std::uniform_int_distribution<int> distribution(0,size-1);
-
-    Handle source = atoms[distribution(generator)];
-
-    updateHebbianLinks(source);
+    EcanParamsPtr params = _atq.params();
+    HebbianStorePtr store = _stores->get(*params);
 
-  //Experimental Code
-  //HandleSeq targetSet = get_target_neighbors(source, ASYMMETRIC_HEBBIAN_LINK);
-
-  //for (Handle target : targetSet)
-  //{
-  //    Handle link = a->get_handle(ASYMMETRIC_HEBBIAN_LINK, source, target);
-
-  //    double learningRate = 0.01f;
-  //    double new_tc, old_tc;
-
-  //    auto magnitued = as->get_normalised_zero_to_one_STI(source,true,true);
-  //    auto direction = as->get_normalised_STI(target,true,true);
-
-  //    old_tc = link->getTruthValue()->get_mean();
-
-  //    new_tc = new_tc + magnitued * direction * learningRate;
-  //    new_tc = std::min(std::max(new_tc,0.0),1.0);
-
-  //    //update truth value accordingly
-  //    TruthValuePtr newtv = SimpleTruthValue::createTV(new_tc, 0.1);
-  //    link->merge(newtv);
-  //}
+    _budget.start(params->agent_run_budget);
+    sweep(*store);
+    _budget.stop();
+}
 }
 
-void HebbianUpdatingAgent::updateHebbianLinks(Handle source)
+/*
+ * Updates the links of the AF, a chunk of sources at a time, resuming
+ * the sweep left unfinished by the last run if there is one. Without a
+ * budget the whole AF is updated in one chunk.
+ */
+void HebbianUpdatingAgent::sweep(HebbianStore& store)
 {
-    double tcDecayRate = 0.1f;
-    double tc, old_tc, new_tc;
-
-    IncomingSet links = source->getIncomingSetByType(ASYMMETRIC_HEBBIAN_LINK);
-
-    for (const Handle& h : links) {
-        if (source != h->getOutgoingAtom(0))
-            continue;
-        const HandleSeq& outgoing = h->getOutgoingSet();
-        new_tc = targetConjunction(outgoing);
-
-        // old link strength decays
-        TruthValuePtr oldtv  = TruthValueCast(h->getValue(truth_key()));
-        old_tc = oldtv->get_mean();
-        tc = tcDecayRate * new_tc + (1.0 - tcDecayRate) * old_tc;
-
-        //update truth value accordingly
-        // TruthValuePtr newtv = SimpleTruthValue::createTV(tc, 0.1);
-        // h->setValue(truth_key(), h->getValue(truth_key())->merge(newtv));
-        // merge does not exist any longer.
+    if (_cursor >= _sweep.size()) {
+        _sweep.clear();
+        _cursor = 0;
+        _bank->get_handle_set_in_attentional_focus(std::back_inserter(_sweep));
     }
+
+    size_t chunk = _budget.unlimited() ? _sweep.size() : UPDATE_CHUNK;
+    while (_cursor < _sweep.size())
+    {
+        size_t end = std::min(_cursor + chunk, _sweep.size());
+        HandleSeq sources;
+        for (; _cursor < end; _cursor++) {
+            // Removed from the AtomSpace since the snapshot was taken.
+            if (nullptr == _sweep[_cursor]->getAtomSpace()) continue;
+            sources.push_back(_sweep[_cursor]);
+        }
+        if (not sources.empty())
+            updateHebbianLinks(store, sources);
+
+        if (_budget.exhausted()) break;
+    }
+
+    if (_cursor < _sweep.size()) _budget.defer();
 }
 
-double HebbianUpdatingAgent::targetConjunction(HandleSeq handles)
+/*
+ * Reads the rows of all the sources, normalises the STI of every atom
+ * they touch once, and then works out the new strength of every link in
+ * one pass over flat arrays, which the compiler can vectorise. The
+ * strengths are committed with one call to the store.
+ *
+ * The target conjunction of a link from i to j is
+ *
+ *    ((n_i * n_j) + (n_j - n_i) * |n_j - n_i| + 1) / 2
+ *
+ * where n is the STI normalised to [0, 1], and the old strength decays
+ * towards it.
+ */
+void HebbianUpdatingAgent::updateHebbianLinks(HebbianStore& store,
+                                              const HandleSeq& sources)
 {
-    if (handles.size() != 2)
+    const double tcDecayRate = 0.1;
+
+    // The atoms that take part, each once, and for every link the
+    // positions of its two atoms.
+    HandleSeq atoms;
+    std::unordered_map<Handle, size_t> index;
+    auto position = [&](const Handle& h)
     {
-        throw RuntimeException(
-                TRACE_INFO,
-                "Size of outgoing set of a hebbian link must be 2.");
+        auto res = index.emplace(h, atoms.size());
+        if (res.second) atoms.push_back(h);
+        return res.first->second;
+    };
+
+    HebbianStore::Rows rows;
+    rows.reserve(sources.size());
+    std::vector<size_t> from, to;
+    std::vector<double> old_tc;
+    for (const Handle& source : sources) {
+        rows.emplace_back(source, store.row(source));
+        size_t i = position(source);
+        for (const HebbianStore::Weight& w : rows.back().second) {
+            from.push_back(i);
+            to.push_back(position(w.target));
+            old_tc.push_back(w.strength);
+        }
+    }
+
+    size_t n = old_tc.size();
+    if (0 == n) return;
+
+    // Normalise as getNormalisedZeroToOneSTI does, with the bounds read
+    // once for all atoms.
+    AttentionValue::sti_t minSTI = _bank->getMinSTI(true);
+    int normaliser = _bank->getMaxSTI(true) - minSTI;
+    std::vector<double> norm(atoms.size(), 0.0);
+    if (0 != normaliser) {
+        for (size_t a = 0; a < atoms.size(); a++)
+            norm[a] = get_sti(atoms[a]);
+        for (size_t a = 0; a < atoms.size(); a++)
+            norm[a] = std::max(0.0, std::min((norm[a] - minSTI) / normaliser, 1.0));
+    }
+
+    std::vector<double> ni(n), nj(n);
+    for (size_t k = 0; k < n; k++) {
+        ni[k] = norm[from[k]];
+        nj[k] = norm[to[k]];
     }
 
-    auto normsti_i = _bank->getNormalisedZeroToOneSTI(get_av(handles[0]), true, true);
-    auto normsti_j = _bank->getNormalisedZeroToOneSTI(get_av(handles[1]), true, true);
-    double conj = (normsti_i * normsti_j) + ((normsti_j - normsti_i) * std::abs(normsti_j -normsti_i));
+    std::vector<double> tc(n);
+    for (size_t k = 0; k < n; k++) {
+        double d = nj[k] - ni[k];
+        double conj = (ni[k] * nj[k] + d * std::abs(d) + 1.0) / 2.0;
+        tc[k] = tcDecayRate * conj + (1.0 - tcDecayRate) * old_tc[k];
+    }
 
-    conj = (conj + 1.0) / 2.0;
+    size_t k = 0;
+    for (auto& r : rows)
+        for (HebbianStore::Weight& w : r.second)
+            w.strength = tc[k++];
 
-    return conj;
+    store.set_rows(rows);
 }
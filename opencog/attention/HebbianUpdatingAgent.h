@@ -33,6 +33,10 @@
 #include <opencog/attentionbank/avalue/AttentionValue.h>
 #include <opencog/cogserver/modules/agents/Agent.h>
 
+#include "AgentBudget.h"
+#include "AttentionParamQuery.h"
+#include "HebbianStore.h"
+
 namespace opencog
 {
 /** \addtogroup grp_attention
@@ -41,19 +45,36 @@ namespace opencog
 
 class AttentionBank;
 /**
- * This Agent randomly picks an Atom and updates all the outgoing HebbianLinks
+ * This Agent updates all the outgoing HebbianLinks of every Atom in the
+ * AttentionalFocus, on every run.
  *
  * This Agents is supposed to run in it's own Thread.
  *
- * XXX: If there are to few Links they get updated to oft -> fast
+ * The links are read and written a row at a time through the current
+ * HebbianStore, so that with HEBBIAN_DENSE_STORE set an update is a scan
+ * of one matrix row. The new strengths of all the links are computed in
+ * one vectorisable pass and committed together.
+ *
+ * When AGENT_RUN_BUDGET is set, the AF is swept in chunks, and a run that
+ * spends its budget stops between chunks; the next run carries on where
+ * it stopped, before it takes a new snapshot of the AF.
+ *
  * TODO: The exact way to calculate the new/target TV might be improved
  */
 class HebbianUpdatingAgent : public Agent
 {
 private:
     AttentionBank* _bank;
-    double targetConjunction(HandleSeq handles);
-    void updateHebbianLinks(Handle source);
+    AttentionParamQuery _atq;
+    std::shared_ptr<HebbianStoreSelector> _stores;
+
+    // The AF snapshot being swept, and how far the sweep has got.
+    AgentBudget _budget;
+    HandleSeq _sweep;
+    size_t _cursor;
+
+    void sweep(HebbianStore&);
+    void updateHebbianLinks(HebbianStore&, const HandleSeq& sources);
 
 public:
 
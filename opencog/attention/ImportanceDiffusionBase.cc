@@ -25,6 +25,10 @@
 #include <time.h>
 #include <math.h>
 
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+
 #include <opencog/util/algorithm.h>
 #include <opencog/util/Config.h>
 #include <opencog/util/mt19937ar.h>
@@ -38,6 +42,7 @@
 #include <opencog/attentionbank/bank/AttentionBank.h>
 
 #include "ImportanceDiffusionBase.h"
+#include "HebbianStore.h"
 #include "AttentionStat.h"
 #include "AttentionUtils.h"
 #include "Neighbors.h"
@@ -53,16 +58,18 @@ using namespace opencog;
 
 ImportanceDiffusionBase::ImportanceDiffusionBase(CogServer& cs) : Agent(cs)
                          ,_atq(&cs.getAtomSpace())
+                         ,_spreadingFilter(&cs.getAtomSpace(), _atq)
 {
     _bank = &attentionbank(_as);
+    _rates = agent_rate_controller(_as);
+    _stores = hebbian_store_selector(_as);
 
     // Load diffusion parameters
-    maxSpreadPercentage = std::stod(_atq.get_param_value(
-                AttentionParamQuery::dif_spread_percentage));
-    hebbianMaxAllocationPercentage =std::stod(_atq.get_param_value(
-                AttentionParamQuery::heb_max_alloc_percentage));
-    spreadHebbianOnly = std::stoi(_atq.get_param_value(
-                AttentionParamQuery::dif_spread_hebonly));
+    EcanParamsPtr params = _atq.params();
+    _hebbian = _stores->get(*params);
+    maxSpreadPercentage = params->dif_spread_percentage;
+    hebbianMaxAllocationPercentage = params->heb_max_alloc_percentage;
+    spreadHebbianOnly = params->dif_spread_hebonly;
 
     // Provide a logger
     setLogger(new opencog::Logger("ImportanceDiffusionBase.log",
@@ -74,10 +81,13 @@ ImportanceDiffusionBase::~ImportanceDiffusionBase()
 }
 
 /*
- * Diffuses importance from one atom to its non-hebbian incident atoms
- * and hebbian adjacent atoms
+ * Returns the combined probability vector of a source atom
+ *
+ * Calculated from the source's non-hebbian incident atoms and its hebbian
+ * adjacent atoms, weighted according to the configuration parameters. The
+ * entries sum to (at most) 1.0.
  */
-void ImportanceDiffusionBase::diffuseAtom(Handle source)
+std::map<Handle, double> ImportanceDiffusionBase::diffusionVector(Handle source)
 {
     // (1) Find the incident atoms that will be diffused to
     HandleSeq incidentAtoms =
@@ -112,20 +122,6 @@ void ImportanceDiffusionBase::diffuseAtom(Handle source)
                  std::endl;
 #endif
 
-    // (5) Combine the two probability vectors into one according to the
-    //     configuration parameters
-    std::map<Handle, double> probabilityVector = combineIncidentAdjacentVectors(
-                probabilityVectorIncident, probabilityVectorHebbianAdjacent);
-
-#ifdef DEBUG
-    std::cout << "Probability vector contains " << probabilityVector.size() <<
-                 " atoms." << std::endl;
-#endif
-
-    // (6) Calculate the total amount that will be diffused
-    AttentionValue::sti_t totalDiffusionAmount =
-            calculateDiffusionAmount(source);
-
 #ifdef LOG_AV_STAT
     // Log sti gain from spreading via  non-hebbian links
     for(const auto& kv : probabilityVectorIncident){
@@ -146,7 +142,35 @@ void ImportanceDiffusionBase::diffuseAtom(Handle source)
         }
         atom_avstat[kv.first].heblink_sti_gain += kv.second;
     }
+#endif
+
+    // (5) Combine the two probability vectors into one according to the
+    //     configuration parameters
+    std::map<Handle, double> probabilityVector = combineIncidentAdjacentVectors(
+                probabilityVectorIncident, probabilityVectorHebbianAdjacent);
+
+#ifdef DEBUG
+    std::cout << "Probability vector contains " << probabilityVector.size() <<
+                 " atoms." << std::endl;
+#endif
+
+    return probabilityVector;
+}
+
+/*
+ * Diffuses importance from one atom to its non-hebbian incident atoms
+ * and hebbian adjacent atoms
+ */
+void ImportanceDiffusionBase::diffuseAtom(Handle source)
+{
+    // (1)-(5) Determine what proportion to diffuse to each target
+    std::map<Handle, double> probabilityVector = diffusionVector(source);
+
+    // (6) Calculate the total amount that will be diffused
+    AttentionValue::sti_t totalDiffusionAmount =
+            calculateDiffusionAmount(source);
 
+#ifdef LOG_AV_STAT
     // Log amount of sti spread from
     if(atom_avstat.find(source) == atom_avstat.end()){
         AVStat avstat;
@@ -196,6 +220,96 @@ void ImportanceDiffusionBase::diffuseAtom(Handle source)
     // TODO: Support inverse hebbian links
 }
 
+/*
+ * Diffuses importance from all sources at once, Jacobi style
+ *
+ * Every diffusion amount is calculated from the STI the sources had at
+ * the start of the call, before any of this cycle's trades are applied,
+ * and all resulting changes are committed to the bank in one update at
+ * the end. The probability vectors are computed by up to nthreads
+ * threads, each on its own contiguous range of sources, writing only to
+ * that range's slots; no locks are taken.
+ *
+ * The sources are put in atom order first, and the per-atom changes are
+ * summed in that order. The outcome therefore depends only on the
+ * AtomSpace contents, not on the thread count or on thread scheduling.
+ */
+void ImportanceDiffusionBase::diffuseSnapshot(HandleSeq sources,
+                                              unsigned int nthreads)
+{
+    HandleSeq atoms;
+    std::vector<AttentionValue::sti_t> deltas;
+    snapshotDeltas(std::move(sources), nthreads, atoms, deltas);
+
+    // Commit everything in one update.
+    _bank->add_sti(atoms, deltas);
+}
+
+/*
+ * The computing part of diffuseSnapshot(): adds the STI change of every
+ * atom to atoms and deltas, merging it with any change already there,
+ * without touching the bank.
+ */
+void ImportanceDiffusionBase::snapshotDeltas(HandleSeq sources,
+                                             unsigned int nthreads,
+                                             HandleSeq& atoms,
+                                             std::vector<AttentionValue::sti_t>& deltas)
+{
+    std::sort(sources.begin(), sources.end());
+    size_t n = sources.size();
+
+    // (1) Snapshot the diffusion amounts before anything is written.
+    std::vector<AttentionValue::sti_t> amounts(n);
+    for (size_t i = 0; i < n; i++)
+        amounts[i] = calculateDiffusionAmount(sources[i]);
+
+    // (2) Calculate the diffusion events of each source.
+    std::vector<std::vector<DiffusionEventType>> events(n);
+    auto worker = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++) {
+            if (amounts[i] == 0) continue;
+            for (const auto& p : diffusionVector(sources[i])) {
+                events[i].push_back({sources[i], p.first,
+                    (AttentionValue::sti_t) (amounts[i] * p.second)});
+            }
+        }
+    };
+
+#ifdef LOG_AV_STAT
+    // atom_avstat is not thread safe.
+    nthreads = 1;
+#endif
+    nthreads = std::max<size_t>(1, std::min<size_t>(nthreads, n));
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < nthreads; t++)
+        threads.emplace_back(worker, t * n / nthreads, (t + 1) * n / nthreads);
+    worker(0, n / nthreads);
+    for (std::thread& t : threads) t.join();
+
+    // (3) Fold the events into one change per atom, in source order.
+    std::unordered_map<Handle, size_t> slot;
+    for (size_t i = 0; i < atoms.size(); i++)
+        slot.emplace(atoms[i], i);
+    auto add = [&](const Handle& h, AttentionValue::sti_t amount)
+    {
+        auto res = slot.emplace(h, atoms.size());
+        if (res.second) {
+            atoms.push_back(h);
+            deltas.push_back(0);
+        }
+        deltas[res.first->second] += amount;
+    };
+
+    for (const auto& source_events : events) {
+        for (const DiffusionEventType& event : source_events) {
+            add(event.source, -event.amount);
+            add(event.target, event.amount);
+        }
+    }
+}
+
 /*
  * Trades STI between a source atom and a target atom
  */
@@ -218,7 +332,7 @@ void ImportanceDiffusionBase::tradeSTI(DiffusionEventType event)
  * Returns a vector of atom handles that will diffuse STI
  *
  * Calculated as all atoms in the attentional focus (nodes and links)
- * excluding any hebbian links
+ * excluding any hebbian links and atom types named in SPREADING_FILTER
  */
 HandleSeq ImportanceDiffusionBase::diffusionSourceVector(void)
 {
@@ -231,7 +345,7 @@ HandleSeq ImportanceDiffusionBase::diffusionSourceVector(void)
         resultSet.size() << "\n";
 #endif
 
-    removeHebbianLinks(resultSet);
+    _spreadingFilter.filter(resultSet);
 
 #ifdef DEBUG
     std::cout << "Sources Size after removing hebbian links: " <<
@@ -245,7 +359,7 @@ HandleSeq ImportanceDiffusionBase::diffusionSourceVector(void)
  * Returns a vector of atom handles that are incident to a given atom
  *
  * Calculated as the set union of an atom's incoming and outgoing set,
- * excluding hebbian links
+ * excluding hebbian links and any atom type named in SPREADING_FILTER
  */
 HandleSeq ImportanceDiffusionBase::incidentAtoms(Handle h)
 {
@@ -260,17 +374,19 @@ HandleSeq ImportanceDiffusionBase::incidentAtoms(Handle h)
     IncomingSet hIncomingSet = h->getIncomingSet(_as);
     for (const auto& i : hIncomingSet)
     {
+        if (_spreadingFilter.excludes(i->get_type())) continue;
         resultSet.push_back(i->get_handle());
     }
 
     // Calculate and append the outgoing set
     if (h->is_link()) {
-        HandleSeq outgoing = h->getOutgoingSet();
-        resultSet.insert(resultSet.end(), outgoing.begin(), outgoing.end());
+        for (const Handle& out : h->getOutgoingSet())
+        {
+            if (_spreadingFilter.excludes(out)) continue;
+            resultSet.push_back(out);
+        }
     }
 
-    removeHebbianLinks(resultSet);
-
     return resultSet;
 }
 
@@ -284,8 +400,12 @@ HandleSeq ImportanceDiffusionBase::hebbianAdjacentAtoms(Handle h)
 {
     // Chase the hebbian links originating at this atom and obtain the
     // adjacent atoms that are found by traversing those links
-    HandleSeq resultSet =
-            get_target_neighbors(h, ASYMMETRIC_HEBBIAN_LINK);
+    HandleSeq resultSet;
+    for (const HebbianStore::Weight& w : _hebbian->row(h))
+        resultSet.push_back(w.target);
+
+    // Targets of a filtered type do not receive STI either.
+    _spreadingFilter.filter(resultSet);
 
     return resultSet;
 }
@@ -338,18 +458,21 @@ ImportanceDiffusionBase::probabilityVectorHebbianAdjacent(
     // atom, if each hebbian link divided up the total available amount equally
     double maxAllocation = diffusionAvailable / atomCount;
 
+    // The weights of all the hebbian links out of the source, read from
+    // the hebbian store in one go.
+    std::unordered_map<Handle, double> percentage;
+    for (const HebbianStore::Weight& w : _hebbian->row(source))
+        percentage[w.target] =
+            calculateHebbianDiffusionPercentage(w.strength, w.confidence);
+
     // For each hebbian link that will be spread across, discount the
     // amount that is actually allocated to it, based on certain attributes
     // of the link
     for (Handle target : targets)
     {
-        // Find the hebbian link that connects the source atom to this target
-        Handle link = _as->get_handle(ASYMMETRIC_HEBBIAN_LINK, source, target);
-
         // Calculate the discounted diffusion amount based on the link
         // attributes
-        double diffusionAmount =
-                maxAllocation * calculateHebbianDiffusionPercentage(link);
+        double diffusionAmount = maxAllocation * percentage[target];
 
         // Insert the diffusionAmount into the map
         result.insert({target, diffusionAmount});
@@ -464,9 +587,15 @@ ImportanceDiffusionBase::combineIncidentAdjacentVectors(
 double ImportanceDiffusionBase::calculateHebbianDiffusionPercentage(
         Handle h)
 {
-    strength_t strength = h->getValue(turth_key())->get_mean();
-    confidence_t confidence = h->getValue(truth_key())->get_confidence();
+    TruthValuePtr tv = h->getTruthValue();
+
+    return calculateHebbianDiffusionPercentage(tv->get_mean(),
+                                               tv->get_confidence());
+}
 
+double ImportanceDiffusionBase::calculateHebbianDiffusionPercentage(
+        strength_t strength, confidence_t confidence)
+{
     return strength * confidence;
 }
 
@@ -35,7 +35,10 @@
 #include <opencog/util/Logger.h>
 #include <opencog/util/RandGen.h>
 
+#include "AgentRateController.h"
 #include "AttentionParamQuery.h"
+#include "HebbianStore.h"
+#include "SpreadingFilter.h"
 
 class ImportanceDiffusionUTest;
 
@@ -57,6 +60,13 @@ protected:
     double hebbianMaxAllocationPercentage;
     bool spreadHebbianOnly;
     AttentionParamQuery _atq;
+    SpreadingFilter _spreadingFilter;
+    std::shared_ptr<AgentRateController> _rates;
+    std::shared_ptr<HebbianStoreSelector> _stores;
+
+    // The hebbian store of the current cycle. Set by run() before any
+    // diffusion, and only read after that, by worker threads too.
+    HebbianStorePtr _hebbian;
 
     typedef struct DiffusionEventType
     {
@@ -74,17 +84,22 @@ protected:
     HandleSeq hebbianAdjacentAtoms(Handle);
 
     std::map<Handle, double> probabilityVector(HandleSeq);
+    std::map<Handle, double> diffusionVector(Handle);
     std::map<Handle, double> probabilityVectorIncident(HandleSeq);
     std::map<Handle, double> probabilityVectorHebbianAdjacent(Handle, HandleSeq);
     std::map<Handle, double> combineIncidentAdjacentVectors(
             std::map<Handle, double>, std::map<Handle, double>);
 
     double calculateHebbianDiffusionPercentage(Handle);
+    double calculateHebbianDiffusionPercentage(strength_t, confidence_t);
     double calculateIncidentDiffusionPercentage(Handle);
 
     void tradeSTI(DiffusionEventType);
 
     void diffuseAtom(Handle);
+    void diffuseSnapshot(HandleSeq, unsigned int);
+    void snapshotDeltas(HandleSeq, unsigned int, HandleSeq&,
+                        std::vector<AttentionValue::sti_t>&);
     virtual void spreadImportance() = 0;
     virtual AttentionValue::sti_t calculateDiffusionAmount(Handle) = 0;
 
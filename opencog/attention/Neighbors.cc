@@ -25,11 +25,41 @@
 
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include "HebbianStore.h"
 #include "Neighbors.h"
 
 namespace opencog
 {
 
+/*
+ * The hebbian store in use for the atom's AtomSpace, if the query is
+ * for hebbian links. Its edges need not have a link in the AtomSpace;
+ * those of a HebbianGraph, or of an AFHebbianMatrix, usually do not.
+ */
+static HebbianStorePtr hebbian_store(const Handle& h, Type desiredLinkType,
+                                     bool match_subtype)
+{
+    if (not (desiredLinkType == ASYMMETRIC_HEBBIAN_LINK or
+             (match_subtype and
+              nameserver().isA(ASYMMETRIC_HEBBIAN_LINK, desiredLinkType))))
+        return nullptr;
+
+    AtomSpace* as = h->getAtomSpace();
+    if (nullptr == as) return nullptr;
+    return hebbian_store_selector(as)->current();
+}
+
+// Adds the atoms of more that are not in answer yet.
+static void merge(HandleSeq& answer, const HandleSeq& more)
+{
+    UnorderedHandleSet seen(answer.begin(), answer.end());
+    for (const Handle& m : more)
+        if (seen.insert(m).second) answer.push_back(m);
+}
+
 HandleSeq get_target_neighbors(const Handle& h, Type desiredLinkType,
                                bool match_subtype/* = false*/)
 {
@@ -50,6 +80,14 @@ HandleSeq get_target_neighbors(const Handle& h, Type desiredLinkType,
            answer.emplace_back(handle);
         }
     }
+
+    HebbianStorePtr store = hebbian_store(h, desiredLinkType, match_subtype);
+    if (store) {
+        HandleSeq targets;
+        for (const HebbianStore::Weight& w : store->row(h))
+            targets.push_back(w.target);
+        merge(answer, targets);
+    }
     return answer;
 }
 
@@ -75,6 +113,9 @@ HandleSeq get_source_neighbors(const Handle& h, Type desiredLinkType,
             answer.emplace_back(handle);
         }
     }
+
+    HebbianStorePtr store = hebbian_store(h, desiredLinkType, match_subtype);
+    if (store) merge(answer, store->sources(h));
     return answer;
 }
 
@@ -39,6 +39,9 @@ namespace opencog
  *
  * @param h Get neighbours for the atom this handle points to.
  * @param linkType Follow only these types of links.
+ *
+ * For AsymmetricHebbianLinks, the neighbours held by the current
+ * hebbian store are added, as its edges need not be in the AtomSpace.
  */
 HandleSeq get_target_neighbors(const Handle& h, Type desiredLinkType,
                                bool match_subtype = false);
@@ -0,0 +1,180 @@
+/*
+ * opencog/attention/PushImportanceDiffusionAgent.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/attentionbank/bank/AVUtils.h>
+
+#include "PushImportanceDiffusionAgent.h"
+#include "AttentionParamQuery.h"
+
+using namespace opencog;
+using namespace std::placeholders;
+
+PushImportanceDiffusionAgent::PushImportanceDiffusionAgent(CogServer& cs) :
+    ImportanceDiffusionBase(cs), _cycle(0), _pushAmount(0)
+{
+    _threshold = _atq.params()->dif_push_threshold;
+
+    _avConnection = _bank->getAVChangedSignal().connect(
+            std::bind(&PushImportanceDiffusionAgent::avChangedHandler,
+                      this, _1, _2, _3));
+    _removeConnection = _as->atomRemovedSignal().connect(
+            std::bind(&PushImportanceDiffusionAgent::atomRemovedHandler,
+                      this, _1));
+}
+
+PushImportanceDiffusionAgent::~PushImportanceDiffusionAgent()
+{
+    _bank->getAVChangedSignal().disconnect(_avConnection);
+    _as->atomRemovedSignal().disconnect(_removeConnection);
+}
+
+/*
+ * Any increase in STI is added to the atom's residual. This runs in the
+ * thread that changed the AV, so it only does the bookkeeping; filtering
+ * and pushing are left to the agent thread.
+ */
+void PushImportanceDiffusionAgent::avChangedHandler(const Handle& h,
+        const AttentionValuePtr& old_av, const AttentionValuePtr& new_av)
+{
+    AttentionValue::sti_t gain = new_av->getSTI() - old_av->getSTI();
+    if (gain <= 0) return;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    Residual& r = _residual[h];
+    r.amount += gain;
+    r.cycle = _cycle;
+
+    if (not r.queued and r.amount >= _threshold) {
+        r.queued = true;
+        _queue.push_back(h);
+    }
+}
+
+void PushImportanceDiffusionAgent::atomRemovedHandler(const AtomPtr& atom)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _residual.erase(Handle(atom));
+}
+
+void PushImportanceDiffusionAgent::run()
+{
+    // Not yet due, if paced to hold AGENT_CPU_SHARE.
+    if (not _rates->begin(classinfo().id)) return;
+
+    // Reread param values for dynamically updating the values.
+    EcanParamsPtr params = _atq.params();
+    maxSpreadPercentage = params->dif_spread_percentage;
+    hebbianMaxAllocationPercentage = params->heb_max_alloc_percentage;
+    spreadHebbianOnly = params->dif_spread_hebonly;
+    _threshold = params->dif_push_threshold;
+    _spreadingFilter.refresh();
+    _hebbian = _stores->get(*params);
+
+    spreadImportance();
+
+    _rates->end(classinfo().id);
+}
+
+/*
+ * Pushes the residual of every atom that was queued when the cycle
+ * started. Atoms that cross the threshold because of this cycle's pushes
+ * are handled on the next cycle.
+ */
+void PushImportanceDiffusionAgent::spreadImportance()
+{
+    std::deque<Handle> sources;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        sources.swap(_queue);
+        if (0 == ++_cycle % RESIDUAL_CYCLES) ageResiduals();
+    }
+
+    for (const Handle& source : sources)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            auto it = _residual.find(source);
+
+            // Removed from the AtomSpace since it was queued.
+            if (it == _residual.end()) continue;
+
+            _pushAmount = it->second.amount;
+            _residual.erase(it);
+        }
+
+        if (_spreadingFilter.excludes(source)) continue;
+
+        diffuseAtom(source);
+    }
+
+    // Now, process all of the outstanding diffusion events in the diffusion
+    // stack. The STI received by the targets is fed back into their
+    // residuals through the AV changed signal.
+    processDiffusionStack();
+}
+
+/*
+ * Returns the total amount of STI that the atom will diffuse
+ *
+ * Calculated as the maximum spread percentage multiplied by the residual
+ * being pushed, but never more than the atom actually holds.
+ */
+AttentionValue::sti_t PushImportanceDiffusionAgent::calculateDiffusionAmount(Handle h)
+{
+    AttentionValue::sti_t available =
+            std::min(_pushAmount, std::max(get_sti(h), 0.0));
+
+    return available * maxSpreadPercentage;
+}
+
+/*
+ * Drops the residuals that are not queued and have not grown for
+ * RESIDUAL_CYCLES cycles. Called with _mtx held, once every
+ * RESIDUAL_CYCLES cycles, so the sweep costs O(|residuals| /
+ * RESIDUAL_CYCLES) per cycle on average.
+ */
+void PushImportanceDiffusionAgent::ageResiduals(void)
+{
+    for (auto it = _residual.begin(); it != _residual.end(); )
+    {
+        if (not it->second.queued and
+            RESIDUAL_CYCLES <= _cycle - it->second.cycle)
+            it = _residual.erase(it);
+        else ++it;
+    }
+}
+
+size_t PushImportanceDiffusionAgent::pending(void)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _queue.size();
+}
+
+size_t PushImportanceDiffusionAgent::residuals(void)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _residual.size();
+}
@@ -0,0 +1,122 @@
+/*
+ * opencog/attention/PushImportanceDiffusionAgent.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef PUSHIMPORTANCEDIFFUSIONAGENT_H
+#define PUSHIMPORTANCEDIFFUSIONAGENT_H
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <opencog/attentionbank/bank/AttentionBank.h>
+
+#include "ImportanceDiffusionBase.h"
+
+class ImportanceDiffusionUTest;
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/** Diffuses short term importance outwards from atoms that gained STI.
+ *
+ * Modelled on the push algorithm for approximate personalized PageRank.
+ * Every increase of an atom's STI, whether from stimulation or from
+ * diffusion, is added to that atom's residual: STI that it has received
+ * but not yet passed on. Once an atom's residual reaches
+ * DIFFUSION_PUSH_THRESHOLD it is queued, and on its next cycle the agent
+ * pushes MAX_SPREAD_PERCENTAGE of the residual to the atom's neighbours,
+ * with the same incident and hebbian weighting as the other diffusion
+ * agents. What the neighbours receive becomes their residual in turn, so
+ * a stimulus spreads outwards in geometrically shrinking waves until it
+ * falls below the threshold.
+ *
+ * Only queued atoms are visited, so the work done per cycle is
+ * proportional to the amount of new stimulus, not to the size of the
+ * attentional focus. Residuals below the threshold are kept, and are
+ * pushed once later increases bring them over it, unless the atom gains
+ * nothing for RESIDUAL_CYCLES cycles, after which its residual is
+ * dropped, so that the table does not fill up with atoms that were
+ * touched once.
+ */
+class PushImportanceDiffusionAgent : public ImportanceDiffusionBase
+{
+private:
+    friend class ::ImportanceDiffusionUTest;
+
+    struct Residual {
+        AttentionValue::sti_t amount = 0;
+        bool queued = false;
+        unsigned long cycle = 0;   // Cycle of the last gain
+    };
+
+    std::mutex _mtx; // Guards _residual, _queue and _cycle
+    std::unordered_map<Handle, Residual> _residual;
+    std::deque<Handle> _queue;
+    unsigned long _cycle;
+
+    void ageResiduals(void);
+
+    std::atomic<AttentionValue::sti_t> _threshold;
+
+    // Residual of the source currently being pushed.
+    AttentionValue::sti_t _pushAmount;
+
+    int _avConnection;
+    int _removeConnection;
+
+    void avChangedHandler(const Handle&, const AttentionValuePtr&,
+                          const AttentionValuePtr&);
+    void atomRemovedHandler(const AtomPtr&);
+
+    void spreadImportance();
+    AttentionValue::sti_t calculateDiffusionAmount(Handle);
+
+public:
+    /// Cycles without a gain after which a residual below the threshold
+    /// is dropped.
+    static const unsigned long RESIDUAL_CYCLES = 64;
+
+    PushImportanceDiffusionAgent(CogServer&);
+    ~PushImportanceDiffusionAgent();
+
+    virtual void run();
+    virtual const ClassInfo& classinfo() const { return info(); }
+    static const ClassInfo& info() {
+    static const ClassInfo _ci("opencog::PushImportanceDiffusionAgent");
+        return _ci;
+    }
+
+    /// Number of atoms waiting to push their residual.
+    size_t pending(void);
+
+    /// Number of atoms holding a residual.
+    size_t residuals(void);
+};
+
+/** @}*/
+} // namespace
+
+#endif /* PUSHIMPORTANCEDIFFUSIONAGENT_H */
@@ -0,0 +1,190 @@
+/*
+ * opencog/attention/RandomWalkImportanceDiffusionAgent.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <thread>
+
+#include <opencog/util/mt19937ar.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/bank/AVUtils.h>
+
+#include "RandomWalkImportanceDiffusionAgent.h"
+#include "AttentionParamQuery.h"
+
+using namespace opencog;
+
+RandomWalkImportanceDiffusionAgent::RandomWalkImportanceDiffusionAgent(CogServer& cs) :
+    ImportanceDiffusionBase(cs), _quantum(1), _walkLength(1), _threads(0)
+{
+}
+
+void RandomWalkImportanceDiffusionAgent::run()
+{
+    // Not yet due, if paced to hold AGENT_CPU_SHARE.
+    if (not _rates->begin(classinfo().id)) return;
+
+    // Reread param values for dynamically updating the values.
+    EcanParamsPtr params = _atq.params();
+    maxSpreadPercentage = params->dif_spread_percentage;
+    hebbianMaxAllocationPercentage = params->heb_max_alloc_percentage;
+    spreadHebbianOnly = params->dif_spread_hebonly;
+    _quantum = params->dif_walk_quantum;
+    _walkLength = params->dif_walk_length;
+    _threads = params->dif_jacobi_threads;
+    _spreadingFilter.refresh();
+    _hebbian = _stores->get(*params);
+
+    spreadImportance();
+
+    _rates->end(classinfo().id);
+}
+
+/*
+ * Returns the cumulative transition probabilities of an atom, computing
+ * them on first use in this cycle. The entries may sum to less than one,
+ * in which case the remainder is the probability of staying put.
+ */
+const RandomWalkImportanceDiffusionAgent::Transitions&
+RandomWalkImportanceDiffusionAgent::transitions(const Handle& h,
+                                                TransitionCache& cache)
+{
+    auto it = cache.find(h);
+    if (it != cache.end()) return it->second;
+
+    Transitions& t = cache[h];
+    double cumulative = 0;
+    for (const auto& p : diffusionVector(h)) {
+        cumulative += p.second;
+        t.push_back({p.first, cumulative});
+    }
+    return t;
+}
+
+/*
+ * Sends the amount out from the source in packets, one random walk each,
+ * and records where the packets end up.
+ */
+void RandomWalkImportanceDiffusionAgent::walk(const Handle& source,
+        AttentionValue::sti_t amount, std::mt19937& rng,
+        TransitionCache& cache, DeltaMap& deltas)
+{
+    size_t walks = 1;
+    if (0 < _quantum)
+        walks = std::max(1.0, std::ceil(amount / _quantum));
+    AttentionValue::sti_t packet = amount / walks;
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    for (size_t w = 0; w < walks; w++)
+    {
+        Handle at = source;
+        for (unsigned int step = 0; step < _walkLength; step++)
+        {
+            // After the first hop, continue only as far as the spread
+            // percentage would carry the STI.
+            if (0 < step and uniform(rng) >= maxSpreadPercentage) break;
+
+            const Transitions& t = transitions(at, cache);
+            double u = uniform(rng);
+            auto next = std::lower_bound(t.begin(), t.end(), u,
+                    [](const std::pair<Handle, double>& p, double v)
+                    { return p.second <= v; });
+
+            if (next == t.end()) break;
+            at = next->first;
+        }
+
+        if (at == source) continue;
+        deltas[source] -= packet;
+        deltas[at] += packet;
+    }
+}
+
+void RandomWalkImportanceDiffusionAgent::spreadImportance()
+{
+    HandleSeq sources = diffusionSourceVector();
+    std::sort(sources.begin(), sources.end());
+    size_t n = sources.size();
+    if (0 == n) return;
+
+    // Snapshot the diffusion amounts before anything is written.
+    std::vector<AttentionValue::sti_t> amounts(n);
+    for (size_t i = 0; i < n; i++)
+        amounts[i] = calculateDiffusionAmount(sources[i]);
+
+    size_t nthreads = std::max<size_t>(1, std::min<size_t>(_threads, n));
+#ifdef LOG_AV_STAT
+    // atom_avstat is not thread safe.
+    nthreads = 1;
+#endif
+
+    // Each thread gets its own generator, seeded from the global one,
+    // and its own caches and results.
+    std::vector<unsigned int> seeds(nthreads);
+    for (unsigned int& s : seeds) s = randGen().randint(INT_MAX);
+    std::vector<DeltaMap> deltas(nthreads);
+
+    auto worker = [&](size_t t)
+    {
+        std::mt19937 rng(seeds[t]);
+        TransitionCache cache;
+        for (size_t i = t * n / nthreads; i < (t + 1) * n / nthreads; i++)
+            if (0 < amounts[i])
+                walk(sources[i], amounts[i], rng, cache, deltas[t]);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < nthreads; t++)
+        threads.emplace_back(worker, t);
+    worker(0);
+    for (std::thread& t : threads) t.join();
+
+    // Merge the per-thread results, in thread order, and commit.
+    HandleSeq atoms;
+    std::vector<AttentionValue::sti_t> values;
+    std::unordered_map<Handle, size_t> slot;
+    for (const DeltaMap& dm : deltas) {
+        for (const auto& p : dm) {
+            auto res = slot.emplace(p.first, atoms.size());
+            if (res.second) {
+                atoms.push_back(p.first);
+                values.push_back(0);
+            }
+            values[res.first->second] += p.second;
+        }
+    }
+
+    _bank->add_sti(atoms, values);
+}
+
+/*
+ * Returns the total amount of STI that the atom will diffuse
+ *
+ * Calculated as the maximum spread percentage multiplied by the atom's STI
+ */
+AttentionValue::sti_t RandomWalkImportanceDiffusionAgent::calculateDiffusionAmount(Handle h)
+{
+    return (get_sti(h) * maxSpreadPercentage);
+}
@@ -0,0 +1,94 @@
+/*
+ * opencog/attention/RandomWalkImportanceDiffusionAgent.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef RANDOMWALKIMPORTANCEDIFFUSIONAGENT_H
+#define RANDOMWALKIMPORTANCEDIFFUSIONAGENT_H
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "ImportanceDiffusionBase.h"
+
+class ImportanceDiffusionUTest;
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/** Diffuses short term importance along sampled random walks.
+ *
+ * A Monte Carlo counterpart of the AFImportanceDiffusionAgent, meant for
+ * very large graphs. Each AF atom releases the same diffusion amount as
+ * it would under the AF agent, but split into packets of about
+ * DIFFUSION_WALK_QUANTUM STI. Each packet is carried by one random walk.
+ * At every step the walk moves to a neighbour drawn from the current
+ * atom's probability vector, using the same incident and hebbian
+ * weighting as the other diffusion agents. After the first step it
+ * carries on with probability MAX_SPREAD_PERCENTAGE, for at most
+ * DIFFUSION_WALK_LENGTH steps, and leaves its packet where it stops.
+ *
+ * With a walk length of one, the expected transfer equals that of the
+ * AF agent. Longer walks approximate several cycles of diffusion at
+ * once. The work per cycle is bounded by the diffused STI divided by the
+ * quantum, times the walk length. The sources are split over
+ * DIFFUSION_JACOBI_THREADS threads, each with its own random number
+ * generator. All packets are committed in one bank update.
+ */
+class RandomWalkImportanceDiffusionAgent : public ImportanceDiffusionBase
+{
+private:
+    friend class ::ImportanceDiffusionUTest;
+
+    // Cumulative transition probabilities of one atom.
+    typedef std::vector<std::pair<Handle, double>> Transitions;
+    typedef std::unordered_map<Handle, Transitions> TransitionCache;
+    typedef std::unordered_map<Handle, AttentionValue::sti_t> DeltaMap;
+
+    AttentionValue::sti_t _quantum;
+    unsigned int _walkLength;
+    unsigned int _threads;
+
+    const Transitions& transitions(const Handle&, TransitionCache&);
+    void walk(const Handle& source, AttentionValue::sti_t amount,
+              std::mt19937&, TransitionCache&, DeltaMap&);
+
+    void spreadImportance();
+    AttentionValue::sti_t calculateDiffusionAmount(Handle);
+
+public:
+    RandomWalkImportanceDiffusionAgent(CogServer&);
+
+    virtual void run();
+    virtual const ClassInfo& classinfo() const { return info(); }
+    static const ClassInfo& info() {
+    static const ClassInfo _ci("opencog::RandomWalkImportanceDiffusionAgent");
+        return _ci;
+    }
+};
+
+/** @}*/
+} // namespace
+
+#endif /* RANDOMWALKIMPORTANCEDIFFUSIONAGENT_H */
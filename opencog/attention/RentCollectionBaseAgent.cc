@@ -45,6 +45,7 @@ RentCollectionBaseAgent::RentCollectionBaseAgent(CogServer& cs) :
     Agent(cs), _atq(&cs.getAtomSpace())
 {
     _bank = &attentionbank(_as);
+    _rates = agent_rate_controller(_as);
     load_params();
     // Provide a logger
     setLogger(new opencog::Logger("RentCollectionAgent.log", Logger::FINE, true));
@@ -52,25 +53,30 @@ RentCollectionBaseAgent::RentCollectionBaseAgent(CogServer& cs) :
 
 void RentCollectionBaseAgent::run()
 {
+    // Not yet due, if paced to hold AGENT_CPU_SHARE.
+    if (not _rates->begin(classinfo().id)) return;
+
     load_params();
     HandleSeq targetSet;
     selectTargets(targetSet);
 
-    if (targetSet.size() == 0) return;
+    if (not targetSet.empty())
+        collectRent(targetSet);
 
-    collectRent(targetSet);
+    _rates->end(classinfo().id);
 }
 
 void RentCollectionBaseAgent::load_params(void)
 {
     // init starting wages/rents. these should quickly change and reach
     // stable values, which adapt to the system dynamics
-    STIAtomRent = std::stod(_atq.get_param_value(AttentionParamQuery::rent_starting_sti_rent));
-    LTIAtomRent = std::stod(_atq.get_param_value(AttentionParamQuery::rent_starting_lti_rent));
-    targetSTI = std::stod(_atq.get_param_value(AttentionParamQuery::rent_target_sti_funds));
-    stiFundsBuffer = std::stod(_atq.get_param_value(AttentionParamQuery::rent_sti_funds_buffer));
-    targetLTI = std::stod(_atq.get_param_value(AttentionParamQuery::rent_target_lti_funds));
-    ltiFundsBuffer = std::stod(_atq.get_param_value(AttentionParamQuery::rent_lti_funds_buffer));
+    EcanParamsPtr params = _atq.params();
+    STIAtomRent = params->rent_starting_sti_rent;
+    LTIAtomRent = params->rent_starting_lti_rent;
+    targetSTI = params->rent_target_sti_funds;
+    stiFundsBuffer = params->rent_sti_funds_buffer;
+    targetLTI = params->rent_target_lti_funds;
+    ltiFundsBuffer = params->rent_lti_funds_buffer;
 }
 
 AttentionValue::sti_t RentCollectionBaseAgent::calculate_STI_Rent()
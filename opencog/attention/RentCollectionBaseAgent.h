@@ -31,6 +31,7 @@
 #include <opencog/cogserver/modules/agents/Agent.h>
 #include <opencog/attentionbank/bank/AttentionBank.h>
 
+#include "AgentRateController.h"
 #include "AttentionParamQuery.h"
 
 namespace opencog
@@ -55,6 +56,7 @@ class RentCollectionBaseAgent : public Agent
 protected:
     AttentionBank* _bank;
     AttentionParamQuery _atq;
+    std::shared_ptr<AgentRateController> _rates;
 
     AttentionValue::sti_t STIAtomRent; //!< Current atom STI rent.
     AttentionValue::lti_t LTIAtomRent; //!< Current atom LTI rent.
@@ -65,11 +67,11 @@ protected:
     AttentionValue::sti_t stiFundsBuffer;
     AttentionValue::lti_t ltiFundsBuffer;
 
-    void load_params(void);
-
 public:
     RentCollectionBaseAgent(CogServer& cs);
 
+    void load_params(void);
+
     double calculate_STI_Rent();
     double calculate_LTI_Rent();
 
@@ -0,0 +1,92 @@
+/*
+ * opencog/attention/SPSCQueue.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SPSC_QUEUE_H
+#define _OPENCOG_SPSC_QUEUE_H
+
+#include <atomic>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/**
+ * Bounded, lock-free queue for exactly one producer thread and one
+ * consumer thread. The capacity is rounded up to a power of two.
+ *
+ * The producer only writes _tail and the consumer only writes _head,
+ * each with release ordering after touching the slot, so neither ever
+ * waits for the other; a full queue makes try_push() fail instead.
+ */
+template<class T>
+class SPSCQueue
+{
+private:
+    std::vector<T> _ring;
+    size_t _mask;
+
+    // Kept on separate cache lines, as they are written by different
+    // threads.
+    alignas(64) std::atomic<size_t> _head; // Next slot to read
+    alignas(64) std::atomic<size_t> _tail; // Next slot to write
+
+public:
+    explicit SPSCQueue(size_t capacity) : _head(0), _tail(0)
+    {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        _ring.resize(size);
+        _mask = size - 1;
+    }
+
+    /// Producer side. Returns false if the queue is full.
+    bool try_push(const T& item)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == _ring.size())
+            return false;
+
+        _ring[tail & _mask] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side. Returns false if the queue is empty.
+    bool try_pop(T& item)
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+
+        item = _ring[head & _mask];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_SPSC_QUEUE_H
@@ -0,0 +1,263 @@
+/*
+ * opencog/attention/ShardedWAAgent.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <thread>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/bank/AVUtils.h>
+
+#include "ShardedWAAgent.h"
+
+using namespace opencog;
+
+// Transfers that may be in flight between two shards before the sender
+// has to wait for the receiver.
+static const size_t QUEUE_CAPACITY = 4096;
+
+ShardedWAAgent::ShardedWAAgent(CogServer& cs) :
+    ImportanceDiffusionBase(cs),
+    _sdac(&attentionbank(&cs.getAtomSpace()).getImportance()),
+    _edac(&cs.getAtomSpace(), &_sdac),
+    _dac(&_sdac), _rent(cs), _batchSize(1), _sending(0),
+    _batch(0), _running(0), _stopping(false)
+{
+    resize(1);
+}
+
+ShardedWAAgent::~ShardedWAAgent()
+{
+    stopWorkers();
+}
+
+void ShardedWAAgent::run()
+{
+    // Not yet due, if paced to hold AGENT_CPU_SHARE.
+    if (not _rates->begin(classinfo().id)) return;
+
+    EcanParamsPtr params = _atq.params();
+    maxSpreadPercentage = params->dif_spread_percentage;
+    hebbianMaxAllocationPercentage = params->heb_max_alloc_percentage;
+    spreadHebbianOnly = params->dif_spread_hebonly;
+    _dac = params->dif_exact_decay
+         ? static_cast<ecan::DiffusionAmountCalculator*>(&_edac) : &_sdac;
+    _batchSize = params->dif_wa_batch_size;
+#ifdef LOG_AV_STAT
+    // atom_avstat is not thread safe.
+    resize(1);
+#else
+    resize(std::max(1u, params->dif_wa_shards));
+#endif
+    _spreadingFilter.refresh();
+    _hebbian = _stores->get(*params);
+
+    // Bring the rent clock up to date with the funds once, for all
+    // shards, as the WARentCollectionAgent does on every run.
+    _rent.load_params();
+    _bank->get_rent_clock().set_rates(_rent.calculate_STI_Rent(),
+                                      _rent.calculate_LTI_Rent());
+
+    spreadImportance();
+
+    _rates->end(classinfo().id);
+}
+
+/*
+ * Sets up n shards, with a worker for each but the first. Only called
+ * between batches.
+ */
+void ShardedWAAgent::resize(size_t n)
+{
+    if (_shards.size() == n) return;
+
+    stopWorkers();
+
+    _shards.assign(n, Shard());
+    _queues.clear();
+    for (size_t i = 0; i < n * n; i++)
+        _queues.emplace_back(new TransferQueue(QUEUE_CAPACITY));
+
+    for (size_t s = 1; s < n; s++)
+        _workers.emplace_back(&ShardedWAAgent::work, this, s, _batch);
+}
+
+void ShardedWAAgent::stopWorkers(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(_workMtx);
+        _stopping = true;
+    }
+    _workCV.notify_all();
+    for (std::thread& t : _workers) t.join();
+    _workers.clear();
+    _stopping = false;
+}
+
+/*
+ * The loop of the worker of shard s: waits for a batch newer than the
+ * last one it ran, runs its shard of it, and reports back.
+ */
+void ShardedWAAgent::work(size_t s, unsigned long done)
+{
+    std::unique_lock<std::mutex> lock(_workMtx);
+    while (true)
+    {
+        _workCV.wait(lock, [&] { return _stopping or _batch != done; });
+        if (_stopping) return;
+        done = _batch;
+
+        lock.unlock();
+        runShard(s);
+        lock.lock();
+
+        if (0 == --_running) _doneCV.notify_one();
+    }
+}
+
+void ShardedWAAgent::spreadImportance()
+{
+    spreadBatch(_bank->getRandomAtomsNotInAF(std::max(1u, _batchSize)));
+}
+
+/*
+ * Settles and diffuses the sampled atoms, each on the shard that owns it.
+ */
+void ShardedWAAgent::spreadBatch(const HandleSeq& sampled)
+{
+    if (sampled.empty()) return;
+
+    for (Shard& shard : _shards) {
+        shard.sources.clear();
+        shard.deltas.clear();
+    }
+    for (const Handle& h : sampled)
+        _shards[owner(h)].sources.push_back(h);
+
+    size_t n = _shards.size();
+    _sending = n;
+
+    {
+        std::lock_guard<std::mutex> lock(_workMtx);
+        _running = n - 1;
+        _batch++;
+    }
+    _workCV.notify_all();
+
+    runShard(0);
+
+    std::unique_lock<std::mutex> lock(_workMtx);
+    _doneCV.wait(lock, [&] { return 0 == _running; });
+}
+
+/*
+ * Keeps a transfer to one of the shard's own atoms, and queues any other
+ * for the shard that owns its target. While that queue is full, the
+ * shard takes in what was sent to it, so that no two shards can wait
+ * for each other.
+ */
+void ShardedWAAgent::send(size_t from, const Transfer& t)
+{
+    size_t to = owner(t.target);
+    if (to == from) {
+        _shards[from].deltas[t.target] += t.amount;
+        return;
+    }
+
+    TransferQueue& q = *_queues[from * _shards.size() + to];
+    while (not q.try_push(t)) {
+        receive(from);
+        std::this_thread::yield();
+    }
+}
+
+void ShardedWAAgent::receive(size_t to)
+{
+    Shard& shard = _shards[to];
+    size_t n = _shards.size();
+
+    Transfer t;
+    for (size_t from = 0; from < n; from++) {
+        if (from == to) continue;
+        TransferQueue& q = *_queues[from * n + to];
+        while (q.try_pop(t))
+            shard.deltas[t.target] += t.amount;
+    }
+}
+
+/*
+ * The work of one shard: rent, diffusion and the commit of its atoms.
+ */
+void ShardedWAAgent::runShard(size_t s)
+{
+    Shard& shard = _shards[s];
+
+    for (const Handle& source : shard.sources)
+    {
+        // Atoms of filtered types pay rent, but do not diffuse.
+        _bank->settle_rent(source);
+        if (_spreadingFilter.excludes(source)) continue;
+
+        AttentionValue::sti_t amount = calculateDiffusionAmount(source);
+        if (amount == 0) continue;
+
+        for (const auto& p : diffusionVector(source)) {
+            AttentionValue::sti_t part = amount * p.second;
+            shard.deltas[source] -= part;
+            send(s, {p.first, part});
+        }
+
+        receive(s);
+    }
+
+    // Nothing more can arrive once every shard has stopped sending.
+    _sending--;
+    while (0 < _sending) {
+        receive(s);
+        std::this_thread::yield();
+    }
+    receive(s);
+
+    HandleSeq atoms;
+    std::vector<AttentionValue::sti_t> deltas;
+    atoms.reserve(shard.deltas.size());
+    deltas.reserve(shard.deltas.size());
+    for (const auto& d : shard.deltas) {
+        atoms.push_back(d.first);
+        deltas.push_back(d.second);
+    }
+
+    _bank->add_sti(atoms, deltas);
+}
+
+/*
+ * Returns the total amount of STI that the atom will diffuse
+ *
+ * As in the WAImportanceDiffusionAgent, the STI the atom would have
+ * diffused since it was last visited.
+ */
+AttentionValue::sti_t ShardedWAAgent::calculateDiffusionAmount(Handle h)
+{
+    float current_estimate = _dac->diffused_value(h, maxSpreadPercentage);
+
+    return get_sti(h) - current_estimate;
+}
@@ -0,0 +1,146 @@
+/*
+ * opencog/attention/ShardedWAAgent.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SHARDED_WA_AGENT_H
+#define _OPENCOG_SHARDED_WA_AGENT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/attentionbank/bank/ExactImportanceDiffusion.h>
+#include <opencog/attentionbank/bank/StochasticImportanceDiffusion.h>
+
+#include "ImportanceDiffusionBase.h"
+#include "SPSCQueue.h"
+#include "WARentCollectionAgent.h"
+
+class ImportanceDiffusionUTest;
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/** Whole-AtomSpace diffusion and rent, split over shards of atoms.
+ *
+ * Does the work of the WAImportanceDiffusionAgent and the
+ * WARentCollectionAgent together, for a batch of WA_DIFFUSION_BATCH_SIZE
+ * atoms drawn from outside the AF. The atoms are split by hash into
+ * WA_SHARDS shards, and each shard is driven by a thread of its own,
+ * which is the only one to read or write the STI of the shard's atoms.
+ * The first shard runs on the agent's thread; the others have long-lived
+ * workers, started whenever the number of shards changes and handed a
+ * batch on every run.
+ *
+ * A shard settles the rent of its sampled atoms, works out what they
+ * diffuse, and keeps the STI changes of its own atoms. STI for an atom of
+ * another shard is sent to that shard over a lock-free single producer,
+ * single consumer queue; there is one for every ordered pair of shards.
+ * Once all shards are done sending, each commits its own changes in one
+ * bank update.
+ *
+ * The order in which transfers arrive depends on thread scheduling, so
+ * the result may differ from run to run by rounding.
+ */
+class ShardedWAAgent : public ImportanceDiffusionBase
+{
+private:
+    friend class ::ImportanceDiffusionUTest;
+
+    struct Transfer {
+        Handle target;
+        AttentionValue::sti_t amount;
+    };
+
+    typedef SPSCQueue<Transfer> TransferQueue;
+
+    struct Shard {
+        HandleSeq sources;
+        std::unordered_map<Handle, AttentionValue::sti_t> deltas;
+    };
+
+    ecan::StochasticDiffusionAmountCalculator _sdac;
+    ecan::ExactDiffusionAmountCalculator _edac;
+
+    // One of the above, selected by DIFFUSION_EXACT_DECAY.
+    ecan::DiffusionAmountCalculator* _dac;
+
+    // For its rent calculation only.
+    WARentCollectionAgent _rent;
+
+    unsigned int _batchSize;
+
+    std::vector<Shard> _shards;
+
+    // _queues[from * n + to] carries STI from shard from to shard to.
+    std::vector<std::unique_ptr<TransferQueue>> _queues;
+
+    // Number of shards that may still send.
+    std::atomic<size_t> _sending;
+
+    // Workers for shards 1 to n-1, and the batches handed to them.
+    std::vector<std::thread> _workers;
+    std::mutex _workMtx;
+    std::condition_variable _workCV;   // A batch is ready, or stop
+    std::condition_variable _doneCV;   // All workers are done
+    unsigned long _batch;              // Batches handed out so far
+    size_t _running;                   // Workers still on the batch
+    bool _stopping;
+
+    size_t owner(const Handle& h) const
+    {
+        return std::hash<Handle>()(h) % _shards.size();
+    }
+
+    void resize(size_t);
+    void stopWorkers(void);
+    void work(size_t, unsigned long);
+    void send(size_t, const Transfer&);
+    void receive(size_t);
+    void runShard(size_t);
+
+    void spreadImportance();
+    void spreadBatch(const HandleSeq&);
+    AttentionValue::sti_t calculateDiffusionAmount(Handle);
+
+public:
+    ShardedWAAgent(CogServer&);
+    virtual ~ShardedWAAgent();
+
+    virtual void run();
+    virtual const ClassInfo& classinfo() const { return info(); }
+    static const ClassInfo& info() {
+    static const ClassInfo _ci("opencog::ShardedWAAgent");
+        return _ci;
+    }
+};
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_SHARDED_WA_AGENT_H
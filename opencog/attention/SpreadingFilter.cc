@@ -0,0 +1,112 @@
+/*
+ * opencog/attention/SpreadingFilter.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/core/TypeNode.h>
+#include <opencog/attentionbank/types/atom_types.h>
+
+#include "SpreadingFilter.h"
+
+using namespace opencog;
+using namespace std::placeholders;
+
+SpreadingFilter::SpreadingFilter(AtomSpace* as, AttentionParamQuery& atq) :
+    _as(as), _atq(atq), _stale(true)
+{
+    _hparam = _as->add_node(CONCEPT_NODE,
+                            std::string(AttentionParamQuery::spreading_filter));
+
+    _addConnection = _as->atomAddedSignal().connect(
+            std::bind(&SpreadingFilter::atomAddedHandler, this, _1));
+
+    compile();
+}
+
+SpreadingFilter::~SpreadingFilter()
+{
+    _as->atomAddedSignal().disconnect(_addConnection);
+}
+
+/*
+ * Setting a parameter adds a new StateLink for it, which replaces the
+ * previous one. Only mark the table as stale here; the actual work is
+ * done by the agent thread the next time it calls refresh().
+ */
+void SpreadingFilter::atomAddedHandler(const Handle& h)
+{
+    if (h->get_type() != STATE_LINK) return;
+    if (h->getOutgoingAtom(0) != _hparam) return;
+
+    _stale = true;
+}
+
+bool SpreadingFilter::refresh(void)
+{
+    if (not _stale.exchange(false)) return false;
+    compile();
+    return true;
+}
+
+/*
+ * Mark a type and all of its subtypes as excluded.
+ */
+void SpreadingFilter::exclude(Type parent)
+{
+    for (Type t = 0; t < _excluded.size(); t++)
+        if (nameserver().isA(t, parent))
+            _excluded[t] = true;
+}
+
+void SpreadingFilter::compile(void)
+{
+    _excluded.assign(nameserver().getNumberOfClasses(), false);
+
+    // HebbianLinks are never diffusion targets; they are the
+    // edges along which STI is spread.
+    exclude(HEBBIAN_LINK);
+
+    Handle hvalue = _atq.get_param_hvalue(AttentionParamQuery::spreading_filter);
+    if (nullptr == hvalue) return;
+
+    HandleSeq types;
+    if (hvalue->is_link())
+        types = hvalue->getOutgoingSet();
+    else
+        types.push_back(hvalue);
+
+    for (const Handle& ht : types) {
+        if (not nameserver().isA(ht->get_type(), TYPE_NODE))
+            continue;
+        exclude(TypeNodeCast(ht)->get_kind());
+    }
+}
+
+void SpreadingFilter::filter(HandleSeq& handles) const
+{
+    auto it_end = std::remove_if(handles.begin(), handles.end(),
+            [this](const Handle& h) { return excludes(h); });
+
+    handles.erase(it_end, handles.end());
+}
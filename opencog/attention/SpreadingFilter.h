@@ -0,0 +1,91 @@
+/*
+ * opencog/attention/SpreadingFilter.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SPREADING_FILTER_H
+#define _OPENCOG_SPREADING_FILTER_H
+
+#include <atomic>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "AttentionParamQuery.h"
+
+namespace opencog
+{
+/** \addtogroup grp_attention
+ *  @{
+ */
+
+/**
+ * Compiled form of the SPREADING_FILTER parameter.
+ *
+ * The parameter holds a MemberLink of TypeNodes naming the atom types
+ * that should never receive STI through diffusion. Rather than calling
+ * nameserver().isA() for every handle visited, the filter (including
+ * all subtypes, and always including HebbianLink) is compiled into a
+ * dense per-type table that can be tested in constant time.
+ *
+ * The table is recompiled lazily, by refresh(), after a new StateLink
+ * for SPREADING_FILTER has been added to the AtomSpace.
+ */
+class SpreadingFilter
+{
+private:
+    AtomSpace* _as;
+    AttentionParamQuery& _atq;
+
+    Handle _hparam;
+    std::vector<bool> _excluded;
+    std::atomic<bool> _stale;
+    int _addConnection;
+
+    void atomAddedHandler(const Handle&);
+    void exclude(Type);
+    void compile(void);
+
+public:
+    SpreadingFilter(AtomSpace*, AttentionParamQuery&);
+    ~SpreadingFilter();
+
+    /// Recompile the type table if the SPREADING_FILTER StateLink
+    /// has changed since the last call. Returns true if it did.
+    bool refresh(void);
+
+    bool excludes(Type t) const
+    {
+        return t < _excluded.size() and _excluded[t];
+    }
+
+    bool excludes(const Handle& h) const
+    {
+        return excludes(h->get_type());
+    }
+
+    /// Remove all handles of excluded types from the sequence.
+    void filter(HandleSeq&) const;
+};
+
+/** @}*/
+} // namespace
+
+#endif // _OPENCOG_SPREADING_FILTER_H
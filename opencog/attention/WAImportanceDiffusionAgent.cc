@@ -24,6 +24,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include <opencog/util/Config.h>
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/attentionbank/types/atom_types.h>
@@ -37,7 +39,10 @@ using namespace opencog;
 
 
 WAImportanceDiffusionAgent::WAImportanceDiffusionAgent(CogServer& cs) :
-    ImportanceDiffusionBase(cs)
+    ImportanceDiffusionBase(cs),
+    _sdac(&attentionbank(&cs.getAtomSpace()).getImportance()),
+    _edac(&cs.getAtomSpace(), &_sdac),
+    _dac(&_sdac), _batchSize(1), _jacobiThreads(0)
 {
 }
 
@@ -47,10 +52,22 @@ WAImportanceDiffusionAgent::~WAImportanceDiffusionAgent()
 
 void WAImportanceDiffusionAgent::run()
 {
+    // Not yet due, if paced to hold AGENT_CPU_SHARE.
+    if (not _rates->begin(classinfo().id)) return;
+
     // Read params
-    hebbianMaxAllocationPercentage =std::stod(_atq.get_param_value(
-                                     AttentionParamQuery::dif_tournament_size));
+    EcanParamsPtr params = _atq.params();
+    hebbianMaxAllocationPercentage = params->dif_tournament_size;
+    _dac = params->dif_exact_decay
+         ? static_cast<ecan::DiffusionAmountCalculator*>(&_edac) : &_sdac;
+    _batchSize = params->dif_wa_batch_size;
+    _jacobiThreads = params->dif_jacobi_threads;
+
+    _spreadingFilter.refresh();
+    _hebbian = _stores->get(*params);
     spreadImportance();
+
+    _rates->end(classinfo().id);
 }
 
 /*
@@ -64,6 +81,12 @@ void WAImportanceDiffusionAgent::spreadImportance()
     if (sourceVec.size() == 0)
         return;
 
+    // A batch is diffused from a snapshot and committed in one update.
+    if (1 < sourceVec.size() or 0 < _jacobiThreads) {
+        diffuseSnapshot(sourceVec, _jacobiThreads);
+        return;
+    }
+
     Handle target = sourceVec[0];
 
     // Check the decision function to determine if spreading will occur
@@ -77,18 +100,13 @@ void WAImportanceDiffusionAgent::spreadImportance()
 /*
  * Returns a vector of atom handles that will diffuse STI
  *
- * Calculated as all atoms in the attentional focus (nodes and links)
- * excluding any hebbian links
+ * Calculated as a random batch of atoms from outside the attentional focus,
+ * excluding any atom type named in SPREADING_FILTER
  */
 HandleSeq WAImportanceDiffusionAgent::diffusionSourceVector(void)
 {
-    Handle h = _bank->getRandomAtomNotInAF();
-
-    if(h == Handle::UNDEFINED){
-        return HandleSeq{};
-    }
-    HandleSeq sources{h};
-    removeHebbianLinks(sources);  //XXX Do wee need this?
+    HandleSeq sources = _bank->getRandomAtomsNotInAF(std::max(1u, _batchSize));
+    _spreadingFilter.filter(sources);
     return sources;
 }
 
@@ -100,8 +118,7 @@ HandleSeq WAImportanceDiffusionAgent::diffusionSourceVector(void)
 
 AttentionValue::sti_t WAImportanceDiffusionAgent::calculateDiffusionAmount(Handle h)
 {
-    static ecan::StochasticDiffusionAmountCalculator sdac(&_bank->getImportance());
-    float current_estimate = sdac.diffused_value(h, maxSpreadPercentage);
+    float current_estimate = _dac->diffused_value(h, maxSpreadPercentage);
 
     return get_sti(h) - current_estimate;
 }
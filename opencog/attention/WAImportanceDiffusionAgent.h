@@ -29,9 +29,13 @@
 #define WAIMPORTANCEDIFFUSIONAGENT_H
 
 #include <opencog/cogserver/server/CogServer.h>
+#include <opencog/attentionbank/bank/ExactImportanceDiffusion.h>
+#include <opencog/attentionbank/bank/StochasticImportanceDiffusion.h>
 
 #include "ImportanceDiffusionBase.h"
 
+class ImportanceDiffusionUTest;
+
 namespace opencog
 {
 /** \addtogroup grp_attention
@@ -43,6 +47,10 @@ namespace opencog
  * Diffusion sources consist of STI proportionate based randomly selected set
  * of atoms.
  *
+ * Each run draws WA_DIFFUSION_BATCH_SIZE atoms from outside the AF. A
+ * batch of more than one atom is diffused in snapshot mode and committed
+ * in one update, split over DIFFUSION_JACOBI_THREADS threads.
+ *
  * Supports two types of importance diffusion:
  *
  * (1) Diffusion to atoms that are incident to each atom, consisting of that
@@ -59,6 +67,17 @@ class AtomSpace;
 class WAImportanceDiffusionAgent : public ImportanceDiffusionBase
 {
 private:
+    friend class ::ImportanceDiffusionUTest;
+
+    ecan::StochasticDiffusionAmountCalculator _sdac;
+    ecan::ExactDiffusionAmountCalculator _edac;
+
+    // One of the above, selected by DIFFUSION_EXACT_DECAY.
+    ecan::DiffusionAmountCalculator* _dac;
+
+    unsigned int _batchSize;
+    unsigned int _jacobiThreads;
+
     void spreadImportance();
     AttentionValue::sti_t calculateDiffusionAmount(Handle);
 
@@ -40,12 +40,8 @@
 using namespace opencog;
 
 WARentCollectionAgent::WARentCollectionAgent(CogServer& cs):
-                       RentCollectionBaseAgent(cs),
-                       _sdac(&attentionbank(&cs.getAtomSpace()).getImportance())
+                       RentCollectionBaseAgent(cs)
 {
-    // READ SLEEPING TIME HERE
-    _sti_rent = STIAtomRent;
-    _lti_rent = LTIAtomRent;
 }
 
 void WARentCollectionAgent::selectTargets(HandleSeq &targetSetOut)
@@ -56,25 +52,16 @@ void WARentCollectionAgent::selectTargets(HandleSeq &targetSetOut)
     targetSetOut.push_back(h);
 }
 
+/*
+ * Atoms outside the AF pay rent lazily, against the bank's rent clock.
+ * Each run brings the clock's rates up to date with the funds, and
+ * settles the sampled atom's account, however long it has been idle.
+ */
 void WARentCollectionAgent::collectRent(HandleSeq& targetSet)
 {
-    for (const Handle& h : targetSet) {
-        AttentionValue::sti_t sti = get_sti(h);
-        AttentionValue::lti_t lti = get_lti(h);
-        
-        float last_update_time = _sdac.elapsed_time(h);
-        STIAtomRent = STIAtomRent * last_update_time;
-        LTIAtomRent = LTIAtomRent * last_update_time;
-        
-        double stiRent = calculate_STI_Rent();
-        double ltiRent = calculate_LTI_Rent();
-        if (stiRent > sti)
-            stiRent = sti;
-
-        if (ltiRent > lti)
-            ltiRent = lti;
+    _bank->get_rent_clock().set_rates(calculate_STI_Rent(),
+                                      calculate_LTI_Rent());
 
-        _bank->set_sti(h, sti - stiRent);
-        _bank->set_lti(h, lti - ltiRent);
-    }
+    for (const Handle& h : targetSet)
+        _bank->settle_rent(h);
 }
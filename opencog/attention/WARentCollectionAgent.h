@@ -29,7 +29,6 @@
 
 #include <opencog/util/RandGen.h>
 #include <opencog/cogserver/modules/agents/Agent.h>
-#include <opencog/attentionbank/bank/StochasticImportanceDiffusion.h>
 
 #include "RentCollectionBaseAgent.h"
 
@@ -45,14 +44,13 @@ namespace opencog {
      * in the Bank. The wage is computed as a linear function form the Funds
      * and a Target Value. It is capped to the range 0-2x default Wage.
      *
+     * The rent is charged per second through the bank's rent clock, so a
+     * sampled atom pays for all the time since it was last settled.
+     *
      * This Agent is supposed to run in it's own Thread.
      */
     class WARentCollectionAgent : public RentCollectionBaseAgent
     {
-    private:
-        ecan::StochasticDiffusionAmountCalculator _sdac;
-        unsigned int _sti_rent, _lti_rent;
-
     public:
         const ClassInfo& classinfo() const { return info(); }
 
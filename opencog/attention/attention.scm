@@ -6,13 +6,24 @@
 
 (define-module (opencog attention))
 
+(use-modules (opencog attention-config))
+
+(load-extension (string-append opencog-ext-path-attention "libattention") "opencog_ecan_init")
+
+(export ecan-agent-rates)
+
 (load "attention/default-param-values.scm")
 
 (define-public (ecan-set-spreading-filter . type-symbols)
 "
   ecan-set-spreading-filter TYPE-SYMBOLS
 
-  Set ecan to filter atoms of TYPE-SYMOBLS.
+  Set ecan to filter atoms of TYPE-SYMOBLS. Atoms of these types, and
+  of all of their subtypes, neither diffuse nor receive STI, and the
+  diffusion agents do not traverse them.
+
+  Example:
+     (ecan-set-spreading-filter 'MemberLink 'EvaluationLink)
 "
   (if (not (nil? type-symbols))
     (StateLink
@@ -22,3 +33,21 @@
 
   SPREADING_FILTER
 )
+
+(set-procedure-property! ecan-agent-rates 'documentation
+"
+  ecan-agent-rates
+
+  Return the rates chosen for the ECAN agents to hold AGENT_CPU_SHARE,
+  as a LinkValue with one LinkValue per agent. Each holds the agent's
+  name, and a FloatValue with its runs per second (0 if not paced), its
+  smoothed run time in milliseconds, the STI funds imbalance it removes per
+  run, the share of its AV changes that left the AF alone, and its
+  numbers of runs and of skipped runs. The same figures are listed by
+  the ecan-rates command.
+
+  Example:
+     (State AGENT_CPU_SHARE (Number 0.25))
+     (ecan-agent-rates)
+"
+)
@@ -14,6 +14,9 @@
 (define MAX_LINKS                 (Concept "MAX_LINKS"))
 (define HEBBIAN_MAX_ALLOCATION_PERCENTAGE (Concept "HEBBIAN_MAX_ALLOCATION_PERCENTAGE"))
 (define LOCAL_FAR_LINK_RATIO      (Concept "LOCAL_FAR_LINK_RATIO") )
+(define HEBBIAN_DENSE_STORE       (Concept "HEBBIAN_DENSE_STORE"))
+(define HEBBIAN_PERSIST_THRESHOLD (Concept "HEBBIAN_PERSIST_THRESHOLD"))
+(define HEBBIAN_GRAPH_STORE       (Concept "HEBBIAN_GRAPH_STORE"))
 (define MAX_SPREAD_PERCENTAGE     (Concept "MAX_SPREAD_PERCENTAGE"))
 (define SPREAD_HEBBIAN_ONLY       (Concept "SPREAD_HEBBIAN_ONLY"))
 (define DIFFUSION_TOURNAMENT_SIZE (Concept "DIFFUSION_TOURNAMENT_SIZE"))
@@ -26,6 +29,18 @@
 (define TARGET_LTI_FUNDS_BUFFER   (Concept "TARGET_LTI_FUNDS_BUFFER"))
 (define RENT_TOURNAMENT_SIZE      (Concept "RENT_TOURNAMENT_SIZE"))
 (define SPREADING_FILTER          (Concept "SPREADING_FILTER"))
+(define DIFFUSION_EXACT_DECAY     (Concept "DIFFUSION_EXACT_DECAY"))
+(define DIFFUSION_PUSH_THRESHOLD  (Concept "DIFFUSION_PUSH_THRESHOLD"))
+(define DIFFUSION_JACOBI_THREADS  (Concept "DIFFUSION_JACOBI_THREADS"))
+(define WA_DIFFUSION_BATCH_SIZE   (Concept "WA_DIFFUSION_BATCH_SIZE"))
+(define DIFFUSION_INCREMENTAL_EPSILON (Concept "DIFFUSION_INCREMENTAL_EPSILON"))
+(define DIFFUSION_WALK_QUANTUM    (Concept "DIFFUSION_WALK_QUANTUM"))
+(define DIFFUSION_WALK_LENGTH     (Concept "DIFFUSION_WALK_LENGTH"))
+(define WA_SHARDS                 (Concept "WA_SHARDS"))
+(define PIPELINE_MAINTENANCE      (Concept "PIPELINE_MAINTENANCE"))
+(define AGENT_RUN_BUDGET          (Concept "AGENT_RUN_BUDGET"))
+(define AGENT_CPU_SHARE           (Concept "AGENT_CPU_SHARE"))
+(define COOP_SLICE                (Concept "COOP_SLICE"))
 
 (Member AF_SIZE                   ECAN_PARAM)
 (Member MAX_AF_SIZE               ECAN_PARAM)
@@ -38,10 +53,21 @@
 (Member MAX_LINKS                 ECAN_PARAM)
 (Member HEBBIAN_MAX_ALLOCATION_PERCENTAGE ECAN_PARAM)
 (Member LOCAL_FAR_LINK_RATIO      ECAN_PARAM)
+(Member HEBBIAN_DENSE_STORE       ECAN_PARAM)
+(Member HEBBIAN_PERSIST_THRESHOLD ECAN_PARAM)
+(Member HEBBIAN_GRAPH_STORE       ECAN_PARAM)
 (Member MAX_SPREAD_PERCENTAGE     ECAN_PARAM)
 (Member SPREADING_FILTER          ECAN_PARAM)
 (Member SPREAD_HEBBIAN_ONLY       ECAN_PARAM)
 (Member DIFFUSION_TOURNAMENT_SIZE ECAN_PARAM)
+(Member DIFFUSION_EXACT_DECAY     ECAN_PARAM)
+(Member DIFFUSION_PUSH_THRESHOLD  ECAN_PARAM)
+(Member DIFFUSION_JACOBI_THREADS  ECAN_PARAM)
+(Member WA_DIFFUSION_BATCH_SIZE   ECAN_PARAM)
+(Member DIFFUSION_INCREMENTAL_EPSILON ECAN_PARAM)
+(Member DIFFUSION_WALK_QUANTUM    ECAN_PARAM)
+(Member DIFFUSION_WALK_LENGTH     ECAN_PARAM)
+(Member WA_SHARDS                 ECAN_PARAM)
 (Member STARTING_ATOM_STI_RENT    ECAN_PARAM)
 (Member STARTING_ATOM_LTI_RENT    ECAN_PARAM)
 (Member TARGET_STI_FUNDS          ECAN_PARAM)
@@ -50,6 +76,10 @@
 (Member LTI_FUNDS_BUFFER          ECAN_PARAM)
 (Member TARGET_LTI_FUNDS_BUFFER   ECAN_PARAM)
 (Member RENT_TOURNAMENT_SIZE      ECAN_PARAM)
+(Member PIPELINE_MAINTENANCE      ECAN_PARAM)
+(Member AGENT_RUN_BUDGET          ECAN_PARAM)
+(Member AGENT_CPU_SHARE           ECAN_PARAM)
+(Member COOP_SLICE                ECAN_PARAM)
 
 (State AF_SIZE                   (Number 0.2))
 (State MIN_AF_SIZE               (Number 500))
@@ -61,10 +91,21 @@
 (State MAX_LINKS                 (Number 300))
 (State HEBBIAN_MAX_ALLOCATION_PERCENTAGE (Number 0.05))
 (State LOCAL_FAR_LINK_RATIO      (Number 10))
+(State HEBBIAN_DENSE_STORE       (Number 0))
+(State HEBBIAN_PERSIST_THRESHOLD (Number 0.9))
+(State HEBBIAN_GRAPH_STORE       (Number 0))
 (State MAX_SPREAD_PERCENTAGE     (Number 0.4))
 (State SPREADING_FILTER          (MemberLink (Type "MemberLink")))
 (State SPREAD_HEBBIAN_ONLY       (Number 0))
 (State DIFFUSION_TOURNAMENT_SIZE (Number 5))
+(State DIFFUSION_EXACT_DECAY     (Number 0))
+(State DIFFUSION_PUSH_THRESHOLD  (Number 5))
+(State DIFFUSION_JACOBI_THREADS  (Number 0))
+(State WA_DIFFUSION_BATCH_SIZE   (Number 1))
+(State DIFFUSION_INCREMENTAL_EPSILON (Number 0))
+(State DIFFUSION_WALK_QUANTUM    (Number 1))
+(State DIFFUSION_WALK_LENGTH     (Number 1))
+(State WA_SHARDS                 (Number 4))
 (State STARTING_ATOM_STI_RENT    (Number 1))
 (State STARTING_ATOM_LTI_RENT    (Number 1))
 (State TARGET_STI_FUNDS          (Number 10000))
@@ -73,3 +114,7 @@
 (State LTI_FUNDS_BUFFER          (Number 10000))
 (State TARGET_LTI_FUNDS_BUFFER   (Number 10000))
 (State RENT_TOURNAMENT_SIZE      (Number 5))
+(State PIPELINE_MAINTENANCE      (Number 0))
+(State AGENT_RUN_BUDGET          (Number 0))
+(State AGENT_CPU_SHARE           (Number 0))
+(State COOP_SLICE                (Number 1))
@@ -78,4 +78,21 @@ Handle AtomBins::getRandomAtom(void) const
     return *it;
 }
 
+void AtomBins::getContentAt(size_t i, const std::vector<size_t>& positions,
+                            HandleSeq& out) const
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    const HandleSet& s(_idx.at(i));
+
+    auto it = s.begin();
+    size_t at = 0;
+    for (size_t pos : positions)
+    {
+        if (s.size() <= pos) break;
+        std::advance(it, pos - at);
+        at = pos;
+        out.push_back(*it);
+    }
+}
+
 // ================================================================
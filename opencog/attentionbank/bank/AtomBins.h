@@ -39,15 +39,19 @@ namespace opencog
 
 /**
  * Implements a bin classifier.
+ *
+ * The number of atoms in each bin is mirrored in an atomic counter,
+ * so that bin sizes can be queried without taking the lock.
  */
 class AtomBins
 {
     private:
         mutable std::mutex _mtx;
         HandleSetSeq _idx;
+        std::unique_ptr<std::atomic<size_t>[]> _sizes;
 
     public:
-        AtomBins(size_t sz)
+        AtomBins(size_t sz) : _sizes(new std::atomic<size_t>[sz]())
         {
             _idx.resize(sz);
         }
@@ -55,23 +59,36 @@ class AtomBins
         void insert(size_t i, const Handle& a)
         {
             std::lock_guard<std::mutex> lck(_mtx);
-            _idx.at(i).insert(a);
+            if (_idx.at(i).insert(a).second)
+                _sizes[i].fetch_add(1, std::memory_order_relaxed);
         }
 
         void remove(size_t i, const Handle& a)
         {
             std::lock_guard<std::mutex> lck(_mtx);
-            _idx.at(i).erase(a);
+            if (0 < _idx.at(i).erase(a))
+                _sizes[i].fetch_sub(1, std::memory_order_relaxed);
         }
 
         size_t size(size_t i) const
+        {
+            return _sizes[i].load(std::memory_order_relaxed);
+        }
+
+        bool contains(size_t i, const Handle& a) const
         {
             std::lock_guard<std::mutex> lck(_mtx);
-            return _idx.at(i).size();
+            return 0 < _idx.at(i).count(a);
         }
 
         Handle getRandomAtom(void) const;
 
+        /// Append the atoms at the given positions of bin i to out.
+        /// The positions must be ascending; any past the end of the
+        /// bin are ignored.
+        void getContentAt(size_t i, const std::vector<size_t>& positions,
+                          HandleSeq& out) const;
+
         size_t size() const;
 
         template <typename OutputIterator> OutputIterator
@@ -0,0 +1,209 @@
+/*
+ * opencog/attentionbank/bank/AtomSpillStore.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+#include <functional>
+#include <map>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/util/Logger.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/attentionbank/bank/AttentionBank.h>
+#include <opencog/attentionbank/bank/AtomSpillStore.h>
+
+using namespace opencog;
+using namespace std::placeholders;
+
+// Records are native-endian; the file is only meant for this machine.
+static void put_u32(std::string& out, uint32_t v)
+{
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+static void put_string(std::string& out, const std::string& s)
+{
+    put_u32(out, s.size());
+    out.append(s);
+}
+
+AtomSpillStore::AtomSpillStore(AtomSpace* as, AttentionBank* bank,
+                               const std::string& path)
+    : _as(as), _bank(bank), _path(path), _end(0)
+{
+    _file.open(_path, std::ios::in | std::ios::out |
+                      std::ios::binary | std::ios::trunc);
+    if (not _file.is_open())
+        throw IOException(TRACE_INFO,
+            "AtomSpillStore: cannot open %s", _path.c_str());
+
+    _addConnection = _as->atomAddedSignal().connect(
+            std::bind(&AtomSpillStore::atomAddedHandler, this, _1));
+    _bank->set_spill_store(this);
+}
+
+AtomSpillStore::~AtomSpillStore()
+{
+    _bank->set_spill_store(nullptr);
+    _as->atomAddedSignal().disconnect(_addConnection);
+}
+
+/**
+ * Type name, then either 'N' and the node name, or 'L', the arity and
+ * the outgoing atoms, recursively.
+ */
+void AtomSpillStore::encode(const Handle& h, std::string& out)
+{
+    put_string(out, nameserver().getTypeName(h->get_type()));
+    if (h->is_node()) {
+        out.push_back('N');
+        put_string(out, h->get_name());
+    } else {
+        out.push_back('L');
+        put_u32(out, h->get_arity());
+        for (const Handle& o : h->getOutgoingSet())
+            encode(o, out);
+    }
+}
+
+void AtomSpillStore::spill(const HandleSeq& atoms)
+{
+    // Build all the records first, so that the file is written in one go.
+    std::string buf;
+    std::vector<std::pair<size_t, uint64_t>> entries;
+    entries.reserve(atoms.size());
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    for (const Handle& h : atoms)
+    {
+        std::string atom;
+        encode(h, atom);
+
+        AttentionValuePtr av = get_av(h);
+        TruthValuePtr tv = h->getTruthValue();
+        Record r = {av->getSTI(), av->getLTI(), av->getVLTI(),
+                    tv->get_mean(), tv->get_confidence()};
+
+        entries.emplace_back(h->get_hash(), _end + buf.size());
+        put_string(buf, atom);
+        buf.append(reinterpret_cast<const char*>(&r), sizeof(r));
+    }
+
+    _file.seekp(_end);
+    _file.write(buf.data(), buf.size());
+    _file.flush();
+    if (not _file)
+        throw IOException(TRACE_INFO,
+            "AtomSpillStore: cannot write to %s", _path.c_str());
+
+    _end += buf.size();
+    _index.insert(entries.begin(), entries.end());
+}
+
+/**
+ * Finds the atom's record, reads its values and drops it from the index.
+ * Returns false if the atom is not in the store.
+ */
+bool AtomSpillStore::take(const Handle& h, Record& r)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto range = _index.equal_range(h->get_hash());
+    if (range.first == range.second) return false;
+
+    // Hashes may collide, so compare the atoms themselves.
+    std::string atom;
+    encode(h, atom);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        uint32_t len;
+        _file.seekg(it->second);
+        _file.read(reinterpret_cast<char*>(&len), sizeof(len));
+        if (len != atom.size()) continue;
+
+        std::string stored(len, '\0');
+        _file.read(&stored[0], len);
+        if (stored != atom) continue;
+
+        _file.read(reinterpret_cast<char*>(&r), sizeof(r));
+        if (not _file)
+            throw IOException(TRACE_INFO,
+                "AtomSpillStore: cannot read from %s", _path.c_str());
+
+        _index.erase(it);
+        return true;
+    }
+    return false;
+}
+
+void AtomSpillStore::atomAddedHandler(const Handle& h)
+{
+    Record r;
+    if (not take(h, r)) return;
+
+    h->setTruthValue(SimpleTruthValue::createTV(r.mean, r.confidence));
+    _bank->change_av(h, AttentionValue::createAV(r.sti, r.lti, r.vlti));
+}
+
+Handle AtomSpillStore::reload(const Handle& h)
+{
+    if (h->getAtomSpace()) return h;
+    if (not contains(h)) return Handle::UNDEFINED;
+
+    // The values are restored by atomAddedHandler.
+    return _as->add_atom(h);
+}
+
+bool AtomSpillStore::contains(const Handle& h) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _index.count(h->get_hash()) != 0;
+}
+
+size_t AtomSpillStore::size(void) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _index.size();
+}
+
+uint64_t AtomSpillStore::bytes(void) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _end;
+}
+
+std::shared_ptr<AtomSpillStore> opencog::atom_spill_store(AtomSpace* as,
+                                                          const std::string& path)
+{
+    static std::mutex _mtx;
+    static std::map<AtomSpace*, std::weak_ptr<AtomSpillStore>> _stores;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    std::shared_ptr<AtomSpillStore> store = _stores[as].lock();
+    if (nullptr == store) {
+        store = std::make_shared<AtomSpillStore>(as, &attentionbank(as), path);
+        _stores[as] = store;
+    } else if (store->path() != path) {
+        logger().warn("AtomSpillStore: already spilling to %s, not to %s",
+                      store->path().c_str(), path.c_str());
+    }
+    return store;
+}
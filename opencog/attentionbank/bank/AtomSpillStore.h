@@ -0,0 +1,129 @@
+/*
+ * opencog/attentionbank/bank/AtomSpillStore.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ATOM_SPILL_STORE_H
+#define _OPENCOG_ATOM_SPILL_STORE_H
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/avalue/AttentionValue.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class AttentionBank;
+
+/**
+ * A local, append-only segment file for atoms that have been forgotten,
+ * so that they can come back with their attention and truth values if
+ * they turn out to be needed after all.
+ *
+ * spill() appends one record per atom: the atom itself, encoded by type
+ * name and node name or outgoing set, followed by its AV and the mean
+ * and confidence of its TV. Only a content hash to file offset entry per
+ * atom is kept in memory. Spilling does not remove anything; that is up
+ * to the caller.
+ *
+ * A spilled atom is reloaded when it is referenced again, that is, when
+ * an atom with the same content is added to the AtomSpace; and when a
+ * stale handle to it is stimulated, see reload(). The record is then
+ * read back, its values restored and its index entry dropped. Truth
+ * values come back as SimpleTruthValues.
+ *
+ * There is one store per AtomSpace, see atom_spill_store(); it registers
+ * itself with the bank for as long as it lives. The file is truncated
+ * when the store is opened and is never compacted
+ * while in use, so records of reloaded atoms keep taking up disk space
+ * until then.
+ */
+class AtomSpillStore
+{
+private:
+    AtomSpace* _as;
+    AttentionBank* _bank;
+    std::string _path;
+
+    mutable std::mutex _mtx; // Guards the file and the index
+    std::fstream _file;
+    uint64_t _end;
+    std::unordered_multimap<size_t, uint64_t> _index;
+
+    int _addConnection;
+
+    struct Record {
+        AttentionValue::sti_t sti;
+        AttentionValue::lti_t lti;
+        AttentionValue::vlti_t vlti;
+        double mean;
+        double confidence;
+    };
+
+    static void encode(const Handle&, std::string&);
+    bool take(const Handle&, Record&);
+    void atomAddedHandler(const Handle&);
+
+public:
+    AtomSpillStore(AtomSpace*, AttentionBank*, const std::string& path);
+    ~AtomSpillStore();
+
+    /// Append the atoms, with their current values, to the store.
+    void spill(const HandleSeq&);
+
+    /// True if an atom with the same content is waiting in the store.
+    bool contains(const Handle&) const;
+
+    /**
+     * Bring a spilled atom back into the AtomSpace, with its values.
+     * Returns the handle of the atom in the AtomSpace, or the undefined
+     * handle if the atom is neither in the AtomSpace nor in the store.
+     */
+    Handle reload(const Handle&);
+
+    /// Number of atoms waiting in the store.
+    size_t size(void) const;
+
+    /// Size of the segment file, in bytes.
+    uint64_t bytes(void) const;
+
+    /// The segment file.
+    const std::string& path(void) const { return _path; }
+};
+
+/// Returns the spill store of the given AtomSpace, opening it on the
+/// given file if there is none. It is shared by all callers, and lives
+/// as long as any of them holds it; a store that is already open keeps
+/// its own file.
+std::shared_ptr<AtomSpillStore> atom_spill_store(AtomSpace*,
+                                                 const std::string& path);
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_ATOM_SPILL_STORE_H
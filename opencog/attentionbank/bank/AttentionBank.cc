@@ -22,17 +22,21 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <functional>
+#include <opencog/util/exceptions.h>
 #include <opencog/util/mt19937ar.h>
 
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atomspace/AtomSpace.h>
 #include "AttentionBank.h"
+#include "AtomSpillStore.h"
 #include "AVUtils.h"
 
 using namespace opencog;
+using namespace std::placeholders;
 
-AttentionBank::AttentionBank(AtomSpace* asp)
+AttentionBank::AttentionBank(AtomSpace* asp) : _rentClock(asp)
 {
     startingFundsSTI = fundsSTI = 100000;
     startingFundsLTI = fundsLTI = 100000;
@@ -45,26 +49,159 @@ AttentionBank::AttentionBank(AtomSpace* asp)
     maxAFSize = 100;
 
     _as = asp;
+    _trackDirty = false;
+    _dirtyUsers = 0;
+    _spillStore = nullptr;
+
+    // Unlike the importance index, the LTI index covers every atom, so
+    // that forgetting can find atoms that were never given any LTI.
+    _ltiAddConnection = _as->atomAddedSignal().connect(
+        std::bind(&AttentionBank::ltiAtomAddedHandler, this, _1));
+    _ltiRemoveConnection = _as->atomRemovedSignal().connect(
+        std::bind(&AttentionBank::ltiAtomRemovedHandler, this, _1));
+
+    HandleSeq atoms;
+    _as->get_handles_by_type(atoms, ATOM, true);
+    for (const Handle& h : atoms)
+        _ltiIndex.insertAtom(h, get_lti(h));
 }
 
 AttentionBank::~AttentionBank()
 {
+    if (_trackDirty) {
+        _as->atomAddedSignal().disconnect(_addConnection);
+        _as->atomRemovedSignal().disconnect(_removeConnection);
+        _as->TVChangedSignal().disconnect(_tvConnection);
+    }
+    _as->atomAddedSignal().disconnect(_ltiAddConnection);
+    _as->atomRemovedSignal().disconnect(_ltiRemoveConnection);
 }
 
-void AttentionBank::remove_atom_from_bank(const AtomPtr& atom)
+void AttentionBank::ltiAtomAddedHandler(const Handle& h)
 {
-    std::unique_lock<std::mutex> AFL(AFMutex);
-    auto it = std::find_if(attentionalFocus.begin(), attentionalFocus.end(),
-                [atom](std::pair<Handle, AttentionValuePtr> p)
-                { return p.first == Handle(atom);});
+    _ltiIndex.insertAtom(h, get_lti(h));
+}
 
-    if (it != attentionalFocus.end())
-        attentionalFocus.erase(it);
-    AFL.unlock();
+void AttentionBank::ltiAtomRemovedHandler(const AtomPtr& atom)
+{
+    Handle h(atom);
+    _ltiIndex.removeAtom(h, get_lti(h));
+}
+
+void AttentionBank::set_dirty_tracking(bool enable)
+{
+    std::lock_guard<std::mutex> lock(_dirtyMtx);
+    if (enable) {
+        if (0 < _dirtyUsers++) return;
+    } else {
+        if (0 == _dirtyUsers or 0 < --_dirtyUsers) return;
+    }
+
+    if (enable) {
+        _addConnection = _as->atomAddedSignal().connect(
+            std::bind(&AttentionBank::atomAddedHandler, this, _1));
+        _removeConnection = _as->atomRemovedSignal().connect(
+            std::bind(&AttentionBank::atomRemovedHandler, this, _1));
+        _tvConnection = _as->TVChangedSignal().connect(
+            std::bind(&AttentionBank::TVChangedHandler, this, _1, _2, _3));
+    } else {
+        _as->atomAddedSignal().disconnect(_addConnection);
+        _as->atomRemovedSignal().disconnect(_removeConnection);
+        _as->TVChangedSignal().disconnect(_tvConnection);
+        _dirtyAV.clear();
+        _dirtyNeighbourhood.clear();
+    }
+    _trackDirty = enable;
+}
+
+void AttentionBank::take_dirty(UnorderedHandleSet& av,
+                               UnorderedHandleSet& neighbourhood)
+{
+    UnorderedHandleSet empty_av, empty_neighbourhood;
+    std::lock_guard<std::mutex> lock(_dirtyMtx);
+    av.swap(_dirtyAV);
+    neighbourhood.swap(_dirtyNeighbourhood);
+    _dirtyAV.swap(empty_av);
+    _dirtyNeighbourhood.swap(empty_neighbourhood);
+}
+
+/*
+ * A link changing affects the incoming sets of the atoms it holds, and
+ * the link's own neighbourhood.
+ */
+void AttentionBank::markNeighbourhoodDirty(const Handle& h)
+{
+    std::lock_guard<std::mutex> lock(_dirtyMtx);
+    _dirtyNeighbourhood.insert(h);
+    for (const Handle& out : h->getOutgoingSet())
+        _dirtyNeighbourhood.insert(out);
+}
+
+void AttentionBank::atomAddedHandler(const Handle& h)
+{
+    if (h->is_link()) markNeighbourhoodDirty(h);
+}
 
+void AttentionBank::atomRemovedHandler(const AtomPtr& atom)
+{
     Handle h(atom);
-    _importanceIndex.removeAtom(h);
-    set_av(_as, h, nullptr);
+    if (h->is_link()) markNeighbourhoodDirty(h);
+}
+
+void AttentionBank::TVChangedHandler(const Handle& h,
+                                     const TruthValuePtr& old_tv,
+                                     const TruthValuePtr& new_tv)
+{
+    if (h->is_link()) markNeighbourhoodDirty(h);
+}
+
+void AttentionBank::remove_atoms_from_bank(const HandleSeq& atoms)
+{
+    UnorderedHandleSet gone(atoms.begin(), atoms.end());
+
+    // Atoms dropped from the AF, with the AV they entered it with.
+    std::vector<std::pair<Handle, AttentionValuePtr>> left;
+
+    std::unique_lock<ecan::ElidableMutex> AFL(AFMutex);
+    for (auto it = attentionalFocus.begin(); it != attentionalFocus.end(); )
+    {
+        if (gone.count(it->first)) {
+            afIncomingErase(it->first);
+            left.push_back(*it);
+            if (_rentClock.running()) _rentClock.touch(it->first);
+            _afMembers.erase(it->first);
+            it = attentionalFocus.erase(it);
+        }
+        else ++it;
+    }
+    AFL.unlock();
+
+    _mtx.lock();
+    for (const Handle& h : gone) {
+        AttentionValuePtr av = get_av(h);
+        _importanceIndex.removeAtom(h);
+        _ltiIndex.removeAtom(h, av->getLTI());
+
+        fundsSTI += av->getSTI();
+        fundsLTI += av->getLTI();
+
+        // Atoms already gone from the AtomSpace keep their last AV.
+        // Live atoms stay in the LTI index, which covers every atom,
+        // under their reset AV.
+        if (h->getAtomSpace()) {
+            set_av(_as, h, nullptr);
+            _ltiIndex.insertAtom(h, get_lti(h));
+        }
+    }
+    _importanceIndex.update();
+    _mtx.unlock();
+
+    AFCHSigl& afch = RemoveAFSignal();
+    for (const auto& p : left)
+        afch.emit(p.first, p.second, get_av(p.first));
+
+    logger().fine("remove_atoms_from_bank: %zu atoms, fundsSTI = %f",
+                  gone.size(), fundsSTI);
 }
 
 void AttentionBank::set_sti(const Handle& h, AttentionValue::sti_t stiValue)
@@ -86,6 +223,87 @@ void AttentionBank::set_lti(const Handle& h, AttentionValue::lti_t ltiValue)
     AVChanged(h, old_av, new_av);
 }
 
+void AttentionBank::add_sti(const HandleSeq& atoms,
+                            const std::vector<AttentionValue::sti_t>& deltas)
+{
+    if (atoms.size() != deltas.size())
+        throw InvalidParamException(TRACE_INFO,
+            "add_sti: got %zu atoms but %zu deltas",
+            atoms.size(), deltas.size());
+
+    size_t n = atoms.size();
+    std::vector<AttentionValuePtr> old_avs(n), new_avs(n);
+
+    _mtx.lock();
+    for (size_t i = 0; i < n; i++) {
+        const Handle& h = atoms[i];
+        old_avs[i] = get_av(h);
+        new_avs[i] = AttentionValue::createAV(
+            old_avs[i]->getSTI() + deltas[i],
+            old_avs[i]->getLTI(), old_avs[i]->getVLTI());
+
+        _importanceIndex.updateImportance(h, old_avs[i], new_avs[i]);
+        set_av(_as, h, new_avs[i]);
+        fundsSTI -= deltas[i];
+    }
+    _importanceIndex.update();
+    _mtx.unlock();
+
+    logger().fine("add_sti: %zu atoms, fundsSTI = %f", n, fundsSTI);
+
+    AVsChanged(atoms, old_avs, new_avs);
+}
+
+void AttentionBank::change_av(const HandleSeq& atoms,
+                              const std::vector<AttentionValuePtr>& avs)
+{
+    if (atoms.size() != avs.size())
+        throw InvalidParamException(TRACE_INFO,
+            "change_av: got %zu atoms but %zu attention values",
+            atoms.size(), avs.size());
+
+    size_t n = atoms.size();
+    std::vector<AttentionValuePtr> old_avs(n);
+
+    _mtx.lock();
+    for (size_t i = 0; i < n; i++) {
+        const Handle& h = atoms[i];
+        old_avs[i] = get_av(h);
+
+        _importanceIndex.updateImportance(h, old_avs[i], avs[i]);
+        _ltiIndex.updateLTI(h, old_avs[i], avs[i]);
+        set_av(_as, h, avs[i]);
+        fundsSTI += old_avs[i]->getSTI() - avs[i]->getSTI();
+        fundsLTI += old_avs[i]->getLTI() - avs[i]->getLTI();
+    }
+    _importanceIndex.update();
+    _mtx.unlock();
+
+    logger().fine("change_av: %zu atoms, fundsSTI = %f, fundsLTI = %f",
+                  n, fundsSTI, fundsLTI);
+
+    AVsChanged(atoms, old_avs, avs);
+}
+
+/**
+ * The part of a batched update that happens after the AVs and funds have
+ * been written: mark the atoms dirty, notify listeners and update the AF.
+ */
+void AttentionBank::AVsChanged(const HandleSeq& atoms,
+                               const std::vector<AttentionValuePtr>& old_avs,
+                               const std::vector<AttentionValuePtr>& new_avs)
+{
+    if (_trackDirty) {
+        std::lock_guard<std::mutex> lock(_dirtyMtx);
+        _dirtyAV.insert(atoms.begin(), atoms.end());
+    }
+
+    for (size_t i = 0; i < atoms.size(); i++) {
+        _AVChangedSignal.emit(atoms[i], old_avs[i], new_avs[i]);
+        updateAttentionalFocus(atoms[i], old_avs[i], new_avs[i]);
+    }
+}
+
 void AttentionBank::change_vlti(const Handle& h, int unit)
 {
     AttentionValuePtr old_av = get_av(h);
@@ -111,6 +329,7 @@ void AttentionBank::AVChanged(const Handle& h,
     _mtx.lock();
     // First, update the atom's actual AV.
     set_av(_as, h, new_av);
+    _ltiIndex.updateLTI(h, old_av, new_av);
 
     AttentionValue::sti_t oldSti = old_av->getSTI();
     AttentionValue::sti_t newSti = new_av->getSTI();
@@ -124,6 +343,11 @@ void AttentionBank::AVChanged(const Handle& h,
 
     _mtx.unlock();
 
+    if (_trackDirty) {
+        std::lock_guard<std::mutex> lock(_dirtyMtx);
+        _dirtyAV.insert(h);
+    }
+
     logger().fine("AVChanged: fundsSTI = %d, old_av: %d, new_av: %d",
                    fundsSTI, oldSti, newSti);
 
@@ -139,6 +363,19 @@ void AttentionBank::stimulate(const Handle& h, double stimulus)
     // XXX This is not protected or made atomic in any way ...
     // If two different threads stimulate the same atom at the same
     // time, then the calculations will be bad. Does it matter?
+    // A stale handle to a spilled atom is stimulated in its reloaded
+    // atom. Any other handle is stimulated as it is.
+    AtomSpillStore* store = _spillStore;
+    if (store and nullptr == h->getAtomSpace() and store->contains(h)) {
+        Handle reloaded(store->reload(h));
+        if (reloaded) {
+            stimulate(reloaded, stimulus);
+            return;
+        }
+    }
+
+    settle_rent(h);
+
     AttentionValuePtr oldav(get_av(h));
     AttentionValue::sti_t sti   = oldav->getSTI();
     AttentionValue::lti_t lti   = oldav->getLTI();
@@ -160,6 +397,32 @@ void AttentionBank::stimulate(const Handle& h, double stimulus)
 #endif
 }
 
+void AttentionBank::settle_rent(const Handle& h)
+{
+    if (not _rentClock.running()) return;
+
+    if (atom_is_in_AF(h)) {
+        _rentClock.touch(h);
+        return;
+    }
+
+    AttentionValue::sti_t stiRent;
+    AttentionValue::lti_t ltiRent;
+    _rentClock.owed(h, stiRent, ltiRent);
+    if (0 == stiRent and 0 == ltiRent) return;
+
+    AttentionValuePtr oldav(get_av(h));
+    AttentionValue::sti_t sti = oldav->getSTI();
+    AttentionValue::lti_t lti = oldav->getLTI();
+
+    // Never take more than the atom has.
+    AttentionValuePtr newav = AttentionValue::createAV(
+            sti - std::min(stiRent, sti), lti - std::min(ltiRent, lti),
+            oldav->getVLTI());
+    _importanceIndex.updateImportance(h, oldav, newav);
+    AVChanged(h, oldav, newav);
+}
+
 AttentionValue::sti_t AttentionBank::calculateSTIWage()
 {
     AttentionValue::sti_t funds = getSTIFunds();
@@ -257,13 +520,78 @@ AttentionBank& opencog::attentionbank(AtomSpace* pasp)
 
 bool AttentionBank::atom_is_in_AF(const Handle& h)
 {
-    auto it = std::find_if(attentionalFocus.begin(), attentionalFocus.end(),
-            [h](std::pair<Handle, AttentionValuePtr> p)
-            {
-               if (p.first == h) return true;
-               return false;
-            });
-    return  (it != attentionalFocus.end());
+    std::lock_guard<ecan::ElidableMutex> lock(AFMutex);
+    return 0 < _afMembers.count(h);
+}
+
+/**
+ * Files a link that is in the AF under each of the atoms it holds, in
+ * STI order. Atoms held more than once get the link once. Call with
+ * AFMutex held.
+ */
+void AttentionBank::afIncomingInsert(const Handle& link,
+                                     AttentionValue::sti_t sti)
+{
+    if (not link->is_link()) return;
+
+    auto higher = [](const std::pair<AttentionValue::sti_t, Handle>& a,
+                     const std::pair<AttentionValue::sti_t, Handle>& b)
+    {
+        return a.first > b.first;
+    };
+
+    const HandleSeq& outgoing = link->getOutgoingSet();
+    for (size_t i = 0; i < outgoing.size(); i++)
+    {
+        const Handle& atom = outgoing[i];
+        if (std::find(outgoing.begin(), outgoing.begin() + i, atom)
+                != outgoing.begin() + i) continue;
+
+        AFIncoming& inc = _afIncoming[atom];
+        auto entry = std::make_pair(sti, link);
+        inc.insert(std::upper_bound(inc.begin(), inc.end(), entry, higher),
+                   entry);
+    }
+}
+
+/**
+ * Takes a link that left the AF out of the entries of the atoms it
+ * holds. Call with AFMutex held.
+ */
+void AttentionBank::afIncomingErase(const Handle& link)
+{
+    if (not link->is_link()) return;
+
+    for (const Handle& atom : link->getOutgoingSet())
+    {
+        auto it = _afIncoming.find(atom);
+        if (it == _afIncoming.end()) continue;
+
+        AFIncoming& inc = it->second;
+        inc.erase(std::remove_if(inc.begin(), inc.end(),
+                [&](const std::pair<AttentionValue::sti_t, Handle>& p)
+                { return p.second == link; }), inc.end());
+        if (inc.empty()) _afIncoming.erase(it);
+    }
+}
+
+IncomingSet AttentionBank::get_incoming_set_in_attentional_focus(
+        const Handle& h, Type t)
+{
+    IncomingSet result;
+
+    std::lock_guard<ecan::ElidableMutex> lock(AFMutex);
+    auto it = _afIncoming.find(h);
+    if (it == _afIncoming.end()) return result;
+
+    // The AF keeps atoms removed from the AtomSpace until they are
+    // removed from the bank, and may hold atoms of other AtomSpaces.
+    for (const auto& p : it->second)
+        if (p.second->get_type() == t and
+            nullptr != p.second->getAtomSpace() and
+            _as->in_environ(p.second))
+            result.push_back(p.second);
+    return result;
 }
 
 /**
@@ -273,19 +601,21 @@ void AttentionBank::updateAttentionalFocus(const Handle& h,
                     const AttentionValuePtr& old_av,
                     const AttentionValuePtr& new_av)
 {
-    std::lock_guard<std::mutex> lock(AFMutex);
+    std::lock_guard<ecan::ElidableMutex> lock(AFMutex);
     AttentionValue::sti_t sti = new_av->getSTI();
     auto least = attentionalFocus.begin(); // Atom to be removed from the AF
     bool insertable = false;
-    auto it = std::find_if(attentionalFocus.begin(), attentionalFocus.end(),
-            [h](std::pair<Handle, AttentionValuePtr> p)
-            { return p.first == h;});
 
     // Update the STI value if atoms was already in AF
-    if (it != attentionalFocus.end())
+    if (_afMembers.count(h))
     {
+        auto it = std::find_if(attentionalFocus.begin(), attentionalFocus.end(),
+                [h](std::pair<Handle, AttentionValuePtr> p)
+                { return p.first == h;});
         attentionalFocus.erase(it);
         attentionalFocus.insert(std::make_pair(h, new_av));
+        afIncomingErase(h);
+        afIncomingInsert(h, sti);
         return;
     }
 
@@ -305,6 +635,12 @@ void AttentionBank::updateAttentionalFocus(const Handle& h,
         AttentionValuePtr hrm_old_av = least->second;
 
         attentionalFocus.erase(least);
+        _afMembers.erase(hrm);
+        afIncomingErase(hrm);
+
+        // It paid its rent in the AF up to now.
+        if (_rentClock.running()) _rentClock.touch(hrm);
+
         AFCHSigl& afch = RemoveAFSignal();
         afch.emit(hrm, hrm_old_av, hrm_new_av);
         insertable = true;
@@ -314,26 +650,64 @@ void AttentionBank::updateAttentionalFocus(const Handle& h,
     if (insertable)
     {
         attentionalFocus.insert(std::make_pair(h, new_av));
+        _afMembers.insert(h);
+        afIncomingInsert(h, sti);
         AFCHSigl& afch = AddAFSignal();
         afch.emit(h, old_av, new_av);
     }
 }
 
+// Single draws tried before falling back to drawing a whole batch.
+static const int NOT_IN_AF_DRAWS = 8;
+
+/*
+ * The AF is normally a small part of the bank, so a draw rarely hits
+ * it; drawing again until one misses it is cheaper than a batch sized
+ * to the AF.
+ */
 Handle AttentionBank::getRandomAtomNotInAF(void)
 {
-    UnorderedHandleSet atoms_not_in_af = _importanceIndex.getHandleSet(0);
+    for (int i = 0; i < NOT_IN_AF_DRAWS; i++) {
+        HandleSeq atoms = _importanceIndex.getRandomAtoms(1, 0);
+        if (atoms.empty())
+            return Handle::UNDEFINED;
+        if (not atom_is_in_AF(atoms[0]))
+            return atoms[0];
+    }
+
+    HandleSeq atoms = getRandomAtomsNotInAF(1);
+    if (atoms.empty())
+        return Handle::UNDEFINED;
+
+    return atoms[0];
+}
+
+HandleSeq AttentionBank::getRandomAtomsNotInAF(size_t n)
+{
+    size_t afSize;
+    {
+        std::lock_guard<ecan::ElidableMutex> lock(AFMutex);
+        afSize = _afMembers.size();
+    }
 
+    // Draw enough extra atoms to make up for any that turn out to be
+    // in the AF. Dropping those, and then keeping a random n of the
+    // rest, leaves a uniform sample of the atoms outside the AF.
+    HandleSeq atoms = _importanceIndex.getRandomAtoms(n + afSize, 0);
+
+    // One look at the AF for the whole batch.
     {
-        std::lock_guard<std::mutex> lock(AFMutex);
-        for (const auto& hsp : attentionalFocus) {
-            atoms_not_in_af.erase(hsp.first);
-        }
+        std::lock_guard<ecan::ElidableMutex> lock(AFMutex);
+        atoms.erase(std::remove_if(atoms.begin(), atoms.end(),
+                    [&](const Handle& h) { return _afMembers.count(h); }),
+                    atoms.end());
     }
 
-    if (atoms_not_in_af.empty())
-        return Handle::UNDEFINED;
+    if (n < atoms.size()) {
+        for (size_t i = 0; i < n; i++)
+            std::swap(atoms[i], atoms[i + randGen().randint(atoms.size() - i)]);
+        atoms.resize(n);
+    }
 
-    auto it = atoms_not_in_af.cbegin();
-    std::advance(it, randGen().randint(atoms_not_in_af.size()));
-    return *it;
+    return atoms;
 }
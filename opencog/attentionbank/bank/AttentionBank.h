@@ -26,12 +26,16 @@
 #ifndef _OPENCOG_ATTENTION_BANK_H
 #define _OPENCOG_ATTENTION_BANK_H
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 
 #include <opencog/util/sigslot.h>
 #include <opencog/attentionbank/avalue/AttentionValue.h>
+#include <opencog/attentionbank/bank/ElidableMutex.h>
 #include <opencog/attentionbank/bank/ImportanceIndex.h>
+#include <opencog/attentionbank/bank/LTIIndex.h>
+#include <opencog/attentionbank/bank/RentClock.h>
 #include <opencog/atomspace/AtomSpace.h>
 
 namespace opencog
@@ -51,10 +55,12 @@ typedef SigSlot<const Handle&,
                 const AttentionValuePtr&> AFCHSigl;
 
 class AtomSpace;
+class AtomSpillStore;
+
 class AttentionBank
 {
-    std::mutex _mtx; // For synchronizing STI & LTI funds update
-    std::mutex AFMutex; // For AF fetching and update
+    ecan::ElidableMutex _mtx; // For synchronizing STI & LTI funds update
+    ecan::ElidableMutex AFMutex; // For AF fetching and update
 
     unsigned int maxAFSize;
     struct compare_sti_less {
@@ -66,11 +72,25 @@ class AttentionBank
     };
     std::multiset<std::pair<Handle, AttentionValuePtr>, compare_sti_less> attentionalFocus;
 
+    /** The atoms in attentionalFocus, for O(1) lookups, under AFMutex. */
+    UnorderedHandleSet _afMembers;
+
+    /**
+     * For every atom, the links holding it that are in the AF, highest
+     * STI first. Kept up to date along with the AF, under AFMutex.
+     */
+    typedef std::vector<std::pair<AttentionValue::sti_t, Handle>> AFIncoming;
+    std::unordered_map<Handle, AFIncoming> _afIncoming;
+    void afIncomingInsert(const Handle&, AttentionValue::sti_t);
+    void afIncomingErase(const Handle&);
+
     void updateAttentionalFocus(const Handle&, const AttentionValuePtr&,
                                 const AttentionValuePtr&);
 
     /** AV changes */
     void AVChanged(const Handle&, const AttentionValuePtr&, const AttentionValuePtr&);
+    void AVsChanged(const HandleSeq&, const std::vector<AttentionValuePtr>&,
+                    const std::vector<AttentionValuePtr>&);
 
     /**
      * Signal emitted when an atom crosses in or out of the
@@ -97,13 +117,41 @@ class AttentionBank
     /** The importance index */
     ImportanceIndex _importanceIndex;
 
+    /** The long-term importance index, covering every atom */
+    LTIIndex _ltiIndex;
+    int _ltiAddConnection;
+    int _ltiRemoveConnection;
+    void ltiAtomAddedHandler(const Handle&);
+    void ltiAtomRemovedHandler(const AtomPtr&);
+
     /** Signal emitted when the AV changes. */
     AVCHSigl _AVChangedSignal;
 
     AtomSpace* _as;
 
+    /** Lazy rent for atoms outside the AF, see settle_rent() */
+    ecan::RentClock _rentClock;
+
+    /** Where forgotten atoms may be reloaded from, if anywhere */
+    std::atomic<AtomSpillStore*> _spillStore;
+
+    /** Dirty tracking, see take_dirty() */
+    std::mutex _dirtyMtx;
+    std::atomic<bool> _trackDirty;
+    unsigned int _dirtyUsers;
+    UnorderedHandleSet _dirtyAV;
+    UnorderedHandleSet _dirtyNeighbourhood;
+    int _addConnection;
+    int _removeConnection;
+    int _tvConnection;
+
+    void markNeighbourhoodDirty(const Handle&);
+    void atomAddedHandler(const Handle&);
+    void atomRemovedHandler(const AtomPtr&);
+    void TVChangedHandler(const Handle&, const TruthValuePtr&,
+                          const TruthValuePtr&);
+
     void change_vlti(const Handle&, int);
-    void remove_atom_from_bank(const AtomPtr& atom);
 
 public:
     AttentionBank(AtomSpace*);
@@ -123,6 +171,38 @@ public:
     /** Provide ability for others to find out about AV changes */
     AVCHSigl& getAVChangedSignal() { return _AVChangedSignal; }
 
+    /**
+     * Start or stop recording which atoms have changed. While enabled,
+     * the bank records every atom whose AV changes, and every atom whose
+     * neighbourhood changes: a link holding it was added or removed, or
+     * had its TV changed. Tracking is off by default, as it costs a
+     * locked set insertion per change.
+     *
+     * Calls are counted: tracking stays on until every caller that
+     * enabled it has disabled it again.
+     */
+    void set_dirty_tracking(bool);
+
+    /**
+     * Declare that a single thread is, until further notice, the only
+     * one that reads or changes the bank, so that the funds and AF locks
+     * can be skipped. This is meant for schedulers that run all of the
+     * ECAN agents, one at a time, on one thread. Only switch it while no
+     * other thread is using the bank.
+     */
+    void set_exclusive(bool exclusive) {
+        _mtx.set_elided(exclusive);
+        AFMutex.set_elided(exclusive);
+    }
+    bool is_exclusive() const { return _mtx.elided(); }
+
+    /**
+     * Move the atoms recorded since the previous call into av and
+     * neighbourhood, and start recording afresh. There is only one
+     * record, so there should be only one consumer.
+     */
+    void take_dirty(UnorderedHandleSet& av, UnorderedHandleSet& neighbourhood);
+
     AttentionValue::sti_t get_af_max_sti(void) const
     {
         if (attentionalFocus.rbegin() != attentionalFocus.rend())
@@ -153,6 +233,22 @@ public:
     void change_av(const Handle&, const AttentionValuePtr& new_av);
     void set_sti(const Handle&, AttentionValue::sti_t);
     void set_lti(const Handle&, AttentionValue::lti_t);
+
+    /**
+     * Add deltas[i] to the STI of atoms[i], for all i, as one update:
+     * the funds and the importance index are adjusted under a single
+     * lock, after which the usual AV changed signals are emitted and
+     * the AF is updated, atom by atom. An atom may appear only once.
+     */
+    void add_sti(const HandleSeq& atoms,
+                 const std::vector<AttentionValue::sti_t>& deltas);
+
+    /**
+     * Set the attention value of atoms[i] to avs[i], for all i, as one
+     * update, in the same way as add_sti. An atom may appear only once.
+     */
+    void change_av(const HandleSeq& atoms,
+                   const std::vector<AttentionValuePtr>& avs);
     void inc_vlti(const Handle& h) { change_vlti(h, +1); }
     void dec_vlti(const Handle& h) { change_vlti(h, -1); }
 
@@ -166,6 +262,36 @@ public:
      */
     void stimulate(const Handle&, double stimulus);
 
+    /**
+     * Collect the rent an atom outside the AF has accrued on the rent
+     * clock since it was last settled. Atoms in the AF pay rent to the
+     * AF rent agent instead, so for them this only restarts their
+     * account. Does nothing until the clock has been given its rates.
+     *
+     * Called on stimulation and by the whole-atomspace rent agent;
+     * callers that need an exact STI for an atom outside the AF may
+     * settle it before reading.
+     */
+    void settle_rent(const Handle&);
+
+    /**
+     * Drop the given atoms from the AF and the indexes, and return
+     * their STI and LTI to the funds, all in one go. No AV changed
+     * signals are emitted, but RemoveAFSignal fires for each atom
+     * that was in the AF. Atoms still in the AtomSpace get a reset AV
+     * and stay in the LTI index. Meant for atoms that are being, or
+     * have just been, removed from the AtomSpace.
+     */
+    void remove_atoms_from_bank(const HandleSeq&);
+
+    /**
+     * Set the store that forgotten atoms were spilled to, or nullptr.
+     * Stimulating an atom that is no longer in the AtomSpace reloads it
+     * from there first. Called by AtomSpillStore itself.
+     */
+    void set_spill_store(AtomSpillStore* store) { _spillStore = store; }
+    ecan::RentClock& get_rent_clock() { return _rentClock; }
+
     /**
      * Get the total amount of STI in the AttentionBank, sum of
      * STI across all atoms.
@@ -243,6 +369,7 @@ public:
      */
     double getNormalisedZeroToOneSTI(AttentionValuePtr, bool average, bool clip) const;
 
+    /// Whether the atom is in the AF; takes the AF lock.
     bool atom_is_in_AF(const Handle&);
 
     /**
@@ -251,10 +378,19 @@ public:
      * @return The set of all atoms in the Attentional Focus
      * @note: This method utilizes the ImportanceIndex
      */
+    /**
+     * Gets the links of the given type that hold the atom and are in the
+     * Attentional Focus, highest STI first. Only links in the bank's
+     * AtomSpace, or one of its parents, are returned. Takes time in
+     * proportion to the number of such links in the AF, however large
+     * the full incoming set is.
+     */
+    IncomingSet get_incoming_set_in_attentional_focus(const Handle&, Type);
+
     template <typename OutputIterator> OutputIterator
     get_handle_set_in_attentional_focus(OutputIterator result)
     {
-         std::lock_guard<std::mutex> lock(AFMutex);
+         std::lock_guard<ecan::ElidableMutex> lock(AFMutex);
          for (const auto& p : attentionalFocus) {
              *result++ = p.first;
          }
@@ -273,9 +409,19 @@ public:
         return _importanceIndex;
     }
 
+    /// Return the LTI index, giving direct access to it.
+    LTIIndex& getLTIIndex()
+    {
+        return _ltiIndex;
+    }
+
     /// Return a random atom drawn from outside the AF.
     Handle getRandomAtomNotInAF(void);
 
+    /// Return up to n distinct random atoms drawn from outside the AF,
+    /// in a single pass over the importance index.
+    HandleSeq getRandomAtomsNotInAF(size_t n);
+
     AttentionValue::sti_t getMinSTI(bool average=true) const
     {
         return _importanceIndex.getMinSTI(average);
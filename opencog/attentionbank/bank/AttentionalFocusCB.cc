@@ -50,36 +50,18 @@ bool AttentionalFocusCB::link_match(const PatternTermPtr& ptm, const Handle& lso
 
 IncomingSet AttentionalFocusCB::get_incoming_set(const Handle& h, Type t)
 {
-	IncomingSet incoming_set = h->getIncomingSetByType(t, _as);
-
-	// Discard the part of the incoming set that is below the
-	// AF boundary.  The PM will look only at those links that
-	// this callback returns; thus we avoid searching the low-AF
-	// parts of the hypergraph.
-	IncomingSet filtered_set;
-	for (const auto& l : incoming_set) {
-		if (attentionbank(_as).atom_is_in_AF(Handle(l)))
-			filtered_set.push_back(l);
-	}
-
-	// If nothing is in AF
-	if (filtered_set.empty())
-	{
-		// Returning the empty set abandons the search in this direction.
-		// Search will then backtrack and try a different direction.
-		// ... and that is exactly what should be happening.
-		return filtered_set;
-	}
-
-	auto compare_sti = [&](const Handle& lptr1, const Handle& lptr2)->bool
-	{
-		return get_sti(lptr1) > get_sti(lptr2);
-	};
-
-	// The exploration of the set of patterns proceeds by going through
-	// the incoming set, one by one.  So sorting the incoming set will
-	// cause the exploration to look at the highest STI atoms first.
-	std::sort(filtered_set.begin(), filtered_set.end(), compare_sti);
-
-	return filtered_set;
+	// Only the part of the incoming set that is in the AF, which the
+	// bank keeps ordered by STI. The PM will look only at those links
+	// that this callback returns; thus we avoid searching the low-AF
+	// parts of the hypergraph. The exploration proceeds by going
+	// through the incoming set, one by one, so the highest STI atoms
+	// are looked at first.
+	//
+	// Like the full incoming set in _as, it holds only links that are
+	// visible from _as.
+	//
+	// If nothing is in AF, the empty set abandons the search in this
+	// direction. Search will then backtrack and try a different
+	// direction ... and that is exactly what should be happening.
+	return attentionbank(_as).get_incoming_set_in_attentional_focus(h, t);
 }
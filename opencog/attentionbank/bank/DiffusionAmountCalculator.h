@@ -0,0 +1,70 @@
+/*
+ * opencog/attentionbank/bank/DiffusionAmountCalculator.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_DIFFUSION_AMOUNT_CALCULATOR_H
+#define _OPENCOG_DIFFUSION_AMOUNT_CALCULATOR_H
+
+#include <math.h>
+
+#include <opencog/attentionbank/bank/AVUtils.h>
+
+namespace opencog
+{
+    namespace ecan
+    {
+        /**
+         * The whole-atomspace agents only visit a randomly sampled atom
+         * now and then. When they do, they need to know how long the
+         * atom has been left alone, so that the decay, rent or diffusion
+         * that accumulated in the meantime can be settled in one step.
+         *
+         * Implementations differ in how that elapsed time is obtained:
+         * StochasticDiffusionAmountCalculator estimates it per importance
+         * bin, ExactDiffusionAmountCalculator records it per atom.
+         */
+        class DiffusionAmountCalculator
+        {
+        public:
+            virtual ~DiffusionAmountCalculator() {}
+
+            /**
+             * Returns the time, in seconds, since the atom was last
+             * settled, and marks it as settled now.
+             */
+            virtual float elapsed_time(const Handle& h) = 0;
+
+            /**
+             *  Calculates estimated current STI value of the handle after diffusion.
+             *  @param h A handle
+             *  @param decay_rate percentage decay parameter
+             *
+             *  @returns the calculated current STI after diffusion.
+             */
+            float diffused_value(const Handle& h, float decay_rate)
+            {
+                float average_elapsed_time = elapsed_time(h);
+                return get_sti(h) * pow((1 - decay_rate), average_elapsed_time);
+            }
+        };
+    }
+}
+
+#endif // _OPENCOG_DIFFUSION_AMOUNT_CALCULATOR_H
@@ -0,0 +1,92 @@
+/*
+ * opencog/attentionbank/bank/ElidableMutex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ELIDABLE_MUTEX_H
+#define _OPENCOG_ELIDABLE_MUTEX_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <opencog/util/oc_assert.h>
+
+namespace opencog
+{
+    namespace ecan
+    {
+        /**
+         * A mutex whose locking can be switched off, for when a single
+         * thread is known to be the only user of what it guards.
+         *
+         * While elided, lock() and unlock() do nothing. A lock taken
+         * before the switch is still released by its unlock(). The switch
+         * itself must only be made while no other thread holds or waits
+         * for the mutex.
+         *
+         * The first thread to lock after the switch becomes the owner;
+         * a lock() from any other thread fails an assertion, rather than
+         * going on unguarded.
+         */
+        class ElidableMutex
+        {
+        private:
+            std::mutex _mtx;
+            std::atomic<bool> _elided;
+            std::atomic<std::thread::id> _owner; // Only user while elided
+            bool _held; // Written only by the holder
+
+        public:
+            ElidableMutex() :
+                _elided(false), _owner(std::thread::id()), _held(false) {}
+
+            void lock()
+            {
+                if (_elided) {
+                    std::thread::id owner;
+                    std::thread::id self = std::this_thread::get_id();
+                    if (not _owner.compare_exchange_strong(owner, self))
+                        OC_ASSERT(owner == self,
+                                  "Elided mutex locked by a second thread");
+                    return;
+                }
+                _mtx.lock();
+                _held = true;
+            }
+
+            void unlock()
+            {
+                if (not _held) return;
+                _held = false;
+                _mtx.unlock();
+            }
+
+            void set_elided(bool elided)
+            {
+                _owner = std::thread::id();
+                _elided = elided;
+            }
+            bool elided() const { return _elided; }
+        };
+    } // namespace ecan
+} // namespace opencog
+
+#endif // _OPENCOG_ELIDABLE_MUTEX_H
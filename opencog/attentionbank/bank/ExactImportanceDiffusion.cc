@@ -0,0 +1,106 @@
+/*
+ * opencog/attentionbank/bank/ExactImportanceDiffusion.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <functional>
+
+#include "ExactImportanceDiffusion.h"
+
+using namespace opencog;
+using namespace opencog::ecan;
+using namespace std::placeholders;
+
+ExactDiffusionAmountCalculator::ExactDiffusionAmountCalculator(
+        AtomSpace* as, DiffusionAmountCalculator* fallback)
+    : _as(as), _fallback(fallback), _epoch(std::chrono::steady_clock::now())
+{
+    _removeConnection = _as->atomRemovedSignal().connect(
+            std::bind(&ExactDiffusionAmountCalculator::atomRemovedHandler,
+                      this, _1));
+}
+
+ExactDiffusionAmountCalculator::~ExactDiffusionAmountCalculator()
+{
+    _as->atomRemovedSignal().disconnect(_removeConnection);
+}
+
+void ExactDiffusionAmountCalculator::atomRemovedHandler(const AtomPtr& atom)
+{
+    Handle h(atom);
+    Shard& s = shard(h);
+    std::lock_guard<std::mutex> lock(s.mtx);
+    s.ticks.erase(h);
+}
+
+ExactDiffusionAmountCalculator::tick_t
+ExactDiffusionAmountCalculator::now(void) const
+{
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - _epoch).count();
+
+    // Truncation is intended; see the wrap-around note in the header.
+    return static_cast<tick_t>(ms);
+}
+
+/**
+ *  Calculates the exact elapsed time since the atom was last settled,
+ *  and restarts its clock.
+ *  @param h A handle
+ *
+ *  @returns the elapsed time in seconds; on the first visit, that of
+ *           the fallback calculator, or zero without one.
+ */
+float ExactDiffusionAmountCalculator::elapsed_time(const Handle& h)
+{
+    tick_t t = now();
+    Shard& s = shard(h);
+
+    {
+        std::lock_guard<std::mutex> lock(s.mtx);
+        auto res = s.ticks.emplace(h, t);
+        if (not res.second) {
+            tick_t last = res.first->second;
+            res.first->second = t;
+            return static_cast<tick_t>(t - last) / 1000.0f;
+        }
+    }
+
+    return _fallback ? _fallback->elapsed_time(h) : 0.0f;
+}
+
+void ExactDiffusionAmountCalculator::touch(const Handle& h)
+{
+    tick_t t = now();
+    Shard& s = shard(h);
+
+    std::lock_guard<std::mutex> lock(s.mtx);
+    s.ticks[h] = t;
+}
+
+size_t ExactDiffusionAmountCalculator::size(void)
+{
+    size_t total = 0;
+    for (Shard& s : _shards) {
+        std::lock_guard<std::mutex> lock(s.mtx);
+        total += s.ticks.size();
+    }
+    return total;
+}
@@ -0,0 +1,105 @@
+/*
+ * opencog/attentionbank/bank/ExactImportanceDiffusion.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_EXACT_DIFFUSION_H
+#define _OPENCOG_EXACT_DIFFUSION_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/bank/DiffusionAmountCalculator.h>
+
+namespace opencog
+{
+    namespace ecan
+    {
+        /**
+         * Exact alternative to StochasticDiffusionAmountCalculator.
+         *
+         * Every atom that has been settled at least once carries a 32-bit
+         * last-touched tick (milliseconds since the calculator was
+         * created). The elapsed time of an atom is then simply the
+         * difference between the current tick and its own, so no error
+         * is introduced by the averaging over importance bins. Ticks are
+         * compared with unsigned arithmetic, which stays correct across
+         * wrap-around as long as an atom is revisited at least once every
+         * 2^32 ms (about 49 days).
+         *
+         * An atom that has never been settled has no tick to go by. Its
+         * first visit starts its clock, and takes the elapsed time from
+         * the fallback calculator, typically the stochastic one, if one
+         * was given; without one, nothing is taken as owed.
+         *
+         * The ticks are kept in a side table, sharded by atom hash so that
+         * concurrent agents rarely contend; entries are dropped when the
+         * atom is removed from the AtomSpace. The cost is one small table
+         * entry per visited atom, in exchange for exact, O(1) settlement.
+         */
+        class ExactDiffusionAmountCalculator : public DiffusionAmountCalculator
+        {
+        public:
+            typedef uint32_t tick_t;
+
+        private:
+            static constexpr size_t NUM_SHARDS = 64;
+
+            struct Shard {
+                std::mutex mtx;
+                std::unordered_map<Handle, tick_t> ticks;
+            };
+
+            AtomSpace* _as;
+            DiffusionAmountCalculator* _fallback;
+            std::chrono::steady_clock::time_point _epoch;
+            std::array<Shard, NUM_SHARDS> _shards;
+            int _removeConnection;
+
+            Shard& shard(const Handle& h)
+            {
+                return _shards[h->get_hash() % NUM_SHARDS];
+            }
+
+            void atomRemovedHandler(const AtomPtr&);
+
+        public:
+            ExactDiffusionAmountCalculator(AtomSpace*,
+                    DiffusionAmountCalculator* fallback = nullptr);
+            ~ExactDiffusionAmountCalculator();
+
+            /// Current tick, in milliseconds since construction.
+            tick_t now(void) const;
+
+            float elapsed_time(const Handle& h);
+
+            /// Start (or restart) the atom's clock without reading it.
+            void touch(const Handle& h);
+
+            /// Number of atoms currently carrying a tick.
+            size_t size(void);
+        };
+    }
+}
+
+#endif // _OPENCOG_EXACT_DIFFUSION_H
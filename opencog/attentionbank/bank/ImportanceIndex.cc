@@ -25,10 +25,13 @@
 #include <cmath>
 #include <algorithm>
 #include <functional>
+#include <numeric>
+#include <unordered_set>
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/operators.hpp>
 
+#include <opencog/util/mt19937ar.h>
 #include <opencog/attentionbank/bank/AVUtils.h>
 #include <opencog/attentionbank/bank/ImportanceIndex.h>
 
@@ -48,6 +51,9 @@ using namespace opencog;
 #define GROUP_NUM 12
 #define IMPORTANCE_INDEX_SIZE (GROUP_NUM*GROUP_SIZE)+GROUP_NUM //104
 
+static_assert(IMPORTANCE_INDEX_SIZE+1 == ImportanceIndex::NUM_BINS,
+              "ImportanceIndex::NUM_BINS does not match the bin layout");
+
 //! an output iterator that inserts into a container (without a hint)
 template<typename Container>
 struct insert_output_iterator :
@@ -227,6 +233,62 @@ Handle ImportanceIndex::getRandomAtom(void) const
    return  _index.getRandomAtom();
 }
 
+HandleSeq ImportanceIndex::getRandomAtoms(size_t n,
+                                          AttentionValue::sti_t lowerBound) const
+{
+    HandleSeq ret;
+    if (0 == n or lowerBound < 0) return ret;
+
+    size_t lowerBin = importanceBin(lowerBound);
+
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    // Number the candidate atoms 0..total-1 across the bins, using
+    // the bin sizes only, and draw n of those numbers.
+    size_t total = 0;
+    for (size_t i = lowerBin; i < NUM_BINS; i++)
+        total += _index.size(i);
+
+    std::vector<size_t> picks;
+    if (total <= n) {
+        picks.resize(total);
+        std::iota(picks.begin(), picks.end(), 0);
+    } else {
+        // Floyd's algorithm: n distinct numbers in n draws.
+        std::unordered_set<size_t> chosen;
+        for (size_t j = total - n; j < total; j++) {
+            size_t r = randGen().randint(j + 1);
+            if (not chosen.insert(r).second) chosen.insert(j);
+        }
+        picks.assign(chosen.begin(), chosen.end());
+        std::sort(picks.begin(), picks.end());
+    }
+
+    // Walk the bins once, collecting the picked positions of each.
+    ret.reserve(picks.size());
+    auto pick = picks.begin();
+    size_t offset = 0;
+    std::vector<size_t> positions;
+    for (size_t i = lowerBin; i < NUM_BINS and pick != picks.end(); i++)
+    {
+        size_t sz = _index.size(i);
+        positions.clear();
+        for (; pick != picks.end() and *pick < offset + sz; pick++)
+            positions.push_back(*pick - offset);
+        offset += sz;
+
+        if (not positions.empty())
+            _index.getContentAt(i, positions, ret);
+    }
+
+    // The lowest bin may also hold atoms just below the bound.
+    ret.erase(std::remove_if(ret.begin(), ret.end(),
+                [&](const Handle& h) { return get_sti(h) < lowerBound; }),
+              ret.end());
+
+    return ret;
+}
+
 UnorderedHandleSet ImportanceIndex::getMaxBinContents()
 {
     UnorderedHandleSet ret;
@@ -265,6 +327,5 @@ size_t ImportanceIndex::bin_size() const
 
 size_t ImportanceIndex::size(int i) const
 {
-    std::lock_guard<std::mutex> lock(_mtx);
     return _index.size(i);
 }
@@ -95,6 +95,10 @@ private:
     static size_t importanceBin(AttentionValue::sti_t);
 
 public:
+    /// The number of importance bins. See ImportanceIndex.cc for
+    /// how STI values are mapped onto bins.
+    static constexpr size_t NUM_BINS = 109;
+
     ImportanceIndex();
     void removeAtom(const Handle&);
 
@@ -147,6 +151,17 @@ public:
 
     Handle getRandomAtom(void) const;
 
+    /**
+     * Draws up to n distinct atoms, uniformly at random, from those
+     * with an STI of at least lowerBound. The bins are visited once,
+     * in order, so the result comes out grouped by bin.
+     *
+     * @param n Number of atoms wanted.
+     * @param lowerBound Importance lower bound (inclusive).
+     * @return The sampled atoms; fewer than n if there are not enough.
+     */
+    HandleSeq getRandomAtoms(size_t n, AttentionValue::sti_t lowerBound) const;
+
     /**
      * Get the highest bin which contains Atoms
      */
@@ -160,7 +175,7 @@ public:
     size_t bin_size(void) const;
 
     /**
-     * Get the size of the bin at the given index.
+     * Get the size of the bin at the given index. This does not lock.
      */
     size_t size(int) const;
 };
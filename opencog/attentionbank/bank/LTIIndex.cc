@@ -0,0 +1,162 @@
+/*
+ * opencog/attentionbank/bank/LTIIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include <opencog/attentionbank/bank/AVUtils.h>
+#include <opencog/attentionbank/bank/LTIIndex.h>
+
+using namespace opencog;
+
+LTIIndex::LTIIndex()
+    : _index(NUM_BINS)
+{
+}
+
+size_t LTIIndex::ltiBin(AttentionValue::lti_t lti)
+{
+    if (lti < 0)
+        return 0;
+
+    // Bin 1 holds [0,1), bin 2 [1,2), bin 3 [2,4), bin 4 [4,8) ...
+    int exp;
+    std::frexp(lti, &exp);
+    size_t bin = (lti < 1) ? 1 : 1 + exp;
+
+    return std::min(bin, NUM_BINS - 1);
+}
+
+void LTIIndex::insertAtom(const Handle& h, AttentionValue::lti_t lti)
+{
+    _index.insert(ltiBin(lti), h);
+}
+
+void LTIIndex::removeAtom(const Handle& h, AttentionValue::lti_t lti)
+{
+    _index.remove(ltiBin(lti), h);
+}
+
+void LTIIndex::updateLTI(const Handle& h,
+                         const AttentionValuePtr& oldav,
+                         const AttentionValuePtr& newav)
+{
+    size_t oldbin = ltiBin(oldav->getLTI());
+    size_t newbin = ltiBin(newav->getLTI());
+    if (oldbin == newbin) return;
+
+    _index.remove(oldbin, h);
+    _index.insert(newbin, h);
+}
+
+/*
+ * Min-heap order on (LTI, truth value mean).
+ */
+bool LTIIndex::later(const Entry& a, const Entry& b)
+{
+    if (std::get<0>(a) != std::get<0>(b))
+        return std::get<0>(a) > std::get<0>(b);
+    return std::get<1>(a) > std::get<1>(b);
+}
+
+void LTIIndex::Cursor::reset(void)
+{
+    _bin = 0;
+    _loaded = false;
+    _heap.clear();
+}
+
+void LTIIndex::foreachAscending(AttentionValue::lti_t upperBound,
+        const std::function<bool(const Handle&)>& f) const
+{
+    Cursor cursor;
+    foreachAscending(upperBound, f, cursor);
+}
+
+void LTIIndex::foreachAscending(AttentionValue::lti_t upperBound,
+        const std::function<bool(const Handle&)>& f, Cursor& cursor) const
+{
+    std::vector<Entry>& heap = cursor._heap;
+
+    // Look each key up once, rather than once per comparison.
+    auto entry = [](const Handle& h)
+    {
+        return Entry(get_lti(h), std::fabs(h->getTruthValue()->get_mean()), h);
+    };
+
+    size_t upperBin = ltiBin(upperBound);
+    for (; cursor._bin <= upperBin; cursor._bin++, cursor._loaded = false)
+    {
+        size_t i = cursor._bin;
+        if (not cursor._loaded) {
+            heap.clear();
+            if (0 == _index.size(i)) continue;
+
+            HandleSeq content;
+            _index.getContent(i, std::back_inserter(content));
+            heap.reserve(content.size());
+            for (const Handle& h : content)
+                heap.push_back(entry(h));
+            std::make_heap(heap.begin(), heap.end(), later);
+            cursor._loaded = true;
+        }
+
+        while (not heap.empty())
+        {
+            Entry top = heap.front();
+            const Handle& h = std::get<2>(top);
+
+            // Removed, or moved to another bin, since the bin was ordered.
+            if (not _index.contains(i, h)) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                heap.pop_back();
+                continue;
+            }
+
+            // Changed within the bin since it was ordered.
+            Entry current = entry(h);
+            if (later(current, top) or later(top, current)) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                heap.back() = current;
+                std::push_heap(heap.begin(), heap.end(), later);
+                continue;
+            }
+
+            if (std::get<0>(top) > upperBound) {
+                cursor.reset();
+                return;
+            }
+            if (not f(h)) return;
+
+            std::pop_heap(heap.begin(), heap.end(), later);
+            heap.pop_back();
+        }
+    }
+    cursor.reset();
+}
+
+size_t LTIIndex::size(void) const
+{
+    return _index.size();
+}
@@ -0,0 +1,133 @@
+/*
+ * opencog/attentionbank/bank/LTIIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LTI_INDEX_H
+#define _OPENCOG_LTI_INDEX_H
+
+#include <functional>
+#include <tuple>
+#include <vector>
+
+#include <opencog/attentionbank/avalue/AttentionValue.h>
+#include <opencog/attentionbank/bank/AtomBins.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Implements an index of atoms binned by long-term importance, so that
+ * the least important atoms can be found without scanning the whole
+ * AtomSpace. This index is thread-safe.
+ *
+ * Negative LTI values share the lowest bin; above that the bins are
+ * logarithmic, one per power of two. Unlike the ImportanceIndex, every
+ * atom in the AtomSpace is indexed, including those that still carry
+ * the default attention value; the AttentionBank keeps it in step with
+ * atoms being added and removed.
+ */
+class LTIIndex
+{
+private:
+    AtomBins _index;
+
+    // An atom with the LTI and truth value mean it is ordered by.
+    typedef std::tuple<AttentionValue::lti_t, double, Handle> Entry;
+
+    static size_t ltiBin(AttentionValue::lti_t);
+    static bool later(const Entry&, const Entry&);
+
+public:
+    static constexpr size_t NUM_BINS = 64;
+
+    /**
+     * Where a walk of the index stopped, so that the next call can carry
+     * on from there. Holds the bin being walked and its atoms not yet
+     * visited, ordered as a heap.
+     */
+    class Cursor
+    {
+        friend class LTIIndex;
+
+        size_t _bin = 0;
+        bool _loaded = false;
+        std::vector<Entry> _heap;
+
+    public:
+        /// Start the next walk from the lowest bin again.
+        void reset(void);
+    };
+
+    LTIIndex();
+
+    void insertAtom(const Handle&, AttentionValue::lti_t);
+    void removeAtom(const Handle&, AttentionValue::lti_t);
+
+    /**
+     * Updates the index for the given atom.
+     */
+    void updateLTI(const Handle&,
+                   const AttentionValuePtr& oldav,
+                   const AttentionValuePtr& newav);
+
+    /**
+     * Calls f on atoms in ascending order of LTI, atoms of equal LTI in
+     * ascending order of truth value mean, until f returns false or the
+     * LTI exceeds upperBound.
+     *
+     * Bins are only examined once the walk reaches them, and a bin is
+     * ordered with a heap that is popped one atom at a time, so the cost
+     * is linear in the size of the bins visited plus logarithmic in the
+     * number of atoms handed to f. No lock is held while f runs, so f
+     * may change the AtomSpace; atoms it removes are not passed to it
+     * again.
+     */
+    void foreachAscending(AttentionValue::lti_t upperBound,
+                          const std::function<bool(const Handle&)>& f) const;
+
+    /**
+     * As above, but resumes the walk where the cursor stopped, at the atom
+     * f last returned false for. When f returns false the cursor is left
+     * there; when the walk runs past upperBound or the last bin it is
+     * reset, and the next call starts a new walk.
+     *
+     * Each bin is ordered once per walk, however many calls the walk is
+     * spread over, so a call costs logarithmic time per atom it visits.
+     * Atoms that have left a bin since it was ordered are skipped. A
+     * change of LTI or truth value within the bin is seen when the atom
+     * comes up: one that rose is put back in place, one that fell is
+     * still visited where it was. Atoms that entered a bin the walk has
+     * already reached are only seen by the next walk.
+     */
+    void foreachAscending(AttentionValue::lti_t upperBound,
+                          const std::function<bool(const Handle&)>& f,
+                          Cursor&) const;
+
+    size_t size(void) const;
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_LTI_INDEX_H
@@ -0,0 +1,120 @@
+/*
+ * opencog/attentionbank/bank/RentClock.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <functional>
+
+#include "RentClock.h"
+
+using namespace opencog;
+using namespace opencog::ecan;
+using namespace std::placeholders;
+
+RentClock::RentClock(AtomSpace* as)
+    : _as(as), _last(std::chrono::steady_clock::now()),
+      _integral{0, 0}, _rate{0, 0}, _running(false)
+{
+    _removeConnection = _as->atomRemovedSignal().connect(
+            std::bind(&RentClock::atomRemovedHandler, this, _1));
+}
+
+RentClock::~RentClock()
+{
+    _as->atomRemovedSignal().disconnect(_removeConnection);
+}
+
+void RentClock::atomRemovedHandler(const AtomPtr& atom)
+{
+    Handle h(atom);
+    Shard& s = shard(h);
+    std::lock_guard<std::mutex> lock(s.mtx);
+    s.stamps.erase(h);
+}
+
+/**
+ * Brings the integral up to date with the current time, and returns it.
+ * The caller must hold _mtx.
+ */
+RentClock::Stamp RentClock::advance(void)
+{
+    auto t = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t - _last).count();
+    _last = t;
+
+    _integral.sti += _rate.sti * seconds;
+    _integral.lti += _rate.lti * seconds;
+    return _integral;
+}
+
+void RentClock::set_rates(AttentionValue::sti_t sti,
+                          AttentionValue::lti_t lti)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    advance();
+    _rate = {sti, lti};
+    _running = true;
+}
+
+void RentClock::owed(const Handle& h, AttentionValue::sti_t& sti,
+                     AttentionValue::lti_t& lti)
+{
+    Stamp now;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        now = advance();
+    }
+
+    Shard& s = shard(h);
+    std::lock_guard<std::mutex> lock(s.mtx);
+    auto res = s.stamps.emplace(h, now);
+    if (res.second) {
+        sti = 0;
+        lti = 0;
+        return;
+    }
+
+    sti = now.sti - res.first->second.sti;
+    lti = now.lti - res.first->second.lti;
+    res.first->second = now;
+}
+
+void RentClock::touch(const Handle& h)
+{
+    Stamp now;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        now = advance();
+    }
+
+    Shard& s = shard(h);
+    std::lock_guard<std::mutex> lock(s.mtx);
+    s.stamps[h] = now;
+}
+
+size_t RentClock::size(void)
+{
+    size_t total = 0;
+    for (Shard& s : _shards) {
+        std::lock_guard<std::mutex> lock(s.mtx);
+        total += s.stamps.size();
+    }
+    return total;
+}
@@ -0,0 +1,118 @@
+/*
+ * opencog/attentionbank/bank/RentClock.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_RENT_CLOCK_H
+#define _OPENCOG_RENT_CLOCK_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/attentionbank/avalue/AttentionValue.h>
+
+namespace opencog
+{
+    namespace ecan
+    {
+        /**
+         * Cumulative rent integral, for collecting rent lazily from atoms
+         * outside the attentional focus.
+         *
+         * The clock holds the total STI and LTI rent that a single atom
+         * would have paid since the clock was started, advancing at the
+         * rates last passed to set_rates(). Each settled atom records the
+         * integral at its last settlement, so the rent it owes is simply
+         * the difference between the two. Settling is O(1) no matter how
+         * long the atom was left alone, and exact even if the rates
+         * changed in the meantime.
+         *
+         * As with ExactDiffusionAmountCalculator, an atom that has never
+         * been settled owes nothing; its first settlement starts its
+         * account. The per-atom records are sharded by atom hash and
+         * dropped when the atom is removed from the AtomSpace.
+         */
+        class RentClock
+        {
+        private:
+            static constexpr size_t NUM_SHARDS = 64;
+
+            struct Stamp {
+                AttentionValue::sti_t sti;
+                AttentionValue::lti_t lti;
+            };
+
+            struct Shard {
+                std::mutex mtx;
+                std::unordered_map<Handle, Stamp> stamps;
+            };
+
+            AtomSpace* _as;
+            std::array<Shard, NUM_SHARDS> _shards;
+            int _removeConnection;
+
+            std::mutex _mtx; // Guards the integral and the rates
+            std::chrono::steady_clock::time_point _last;
+            Stamp _integral;
+            Stamp _rate;
+            std::atomic<bool> _running;
+
+            Shard& shard(const Handle& h)
+            {
+                return _shards[h->get_hash() % NUM_SHARDS];
+            }
+
+            Stamp advance(void);
+            void atomRemovedHandler(const AtomPtr&);
+
+        public:
+            RentClock(AtomSpace*);
+            ~RentClock();
+
+            /**
+             * Set the rent charged per atom per second, from now on. The
+             * clock does not run until this has been called once.
+             */
+            void set_rates(AttentionValue::sti_t, AttentionValue::lti_t);
+
+            bool running(void) const { return _running; }
+
+            /**
+             * Get the rent the atom has accrued since it was last
+             * settled, and mark it as settled now. Zero on the first
+             * settlement.
+             */
+            void owed(const Handle&, AttentionValue::sti_t&,
+                      AttentionValue::lti_t&);
+
+            /// Mark the atom as settled now, forgiving what it owes.
+            void touch(const Handle&);
+
+            /// Number of atoms currently holding an account.
+            size_t size(void);
+        };
+    }
+}
+
+#endif // _OPENCOG_RENT_CLOCK_H
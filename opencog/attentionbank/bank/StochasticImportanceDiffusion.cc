@@ -32,10 +32,12 @@
 using namespace opencog;
 using namespace opencog::ecan;
 
-// XXX FIXME - the implementation below is kind-of unusual.
-// It should be restructured so that the importance bins and the
-// diffusion bins are in one-to-one correspondance, so that the
-// integer bin index would not be required to track.
+int64_t StochasticDiffusionAmountCalculator::now(void)
+{
+    return duration_cast<nanoseconds>(
+            high_resolution_clock::now().time_since_epoch()).count();
+}
+
 size_t StochasticDiffusionAmountCalculator::bin_index(const Handle& h)
 {
     return ImportanceIndex::importanceBin(get_sti(h));
@@ -46,34 +48,33 @@ size_t StochasticDiffusionAmountCalculator::bin_size(unsigned int index)
    return _imidx->size(index);
 }
 
-void StochasticDiffusionAmountCalculator::update_bin(const Handle& h)
+void StochasticDiffusionAmountCalculator::update_bin(size_t index, int64_t now)
 {
-    size_t index = bin_index(h);
-    auto it = std::find_if(_bins.begin(), _bins.end(),
-            [=](const DiffusionRecordBin& bin) { return (bin.index == index); });
+    BinRecord& bin = _bins[index];
 
-    if (it == _bins.end())
-    {
-        _bins.push_back(DiffusionRecordBin());
-        it = _bins.begin() + _bins.size()-1;
-    }
-    DiffusionRecordBin& bin = *it;
+    unsigned int count = bin.count.fetch_add(1, std::memory_order_relaxed) + 1;
+    int64_t last = bin.last_update.exchange(now, std::memory_order_relaxed);
+
+    // Two updates of the same bin may happen within the same clock
+    // tick; keep the previous rate rather than dividing by zero.
+    if (now <= last) return;
 
-    bin.index = index;
-    bin.count += 1;
     // using duration_cast<seconds> implicitly or explicitly causes missing
     // fractional seconds.
-    duration<float> sec = high_resolution_clock::now() - bin.last_update;
-    bin.update_rate = bin.count/sec.count();
-
-    bin.last_update = high_resolution_clock::now();
-    bin.size = bin_size(index);
+    duration<float> sec = nanoseconds(now - last);
+    bin.update_rate.store(count/sec.count(), std::memory_order_relaxed);
 }
 
 StochasticDiffusionAmountCalculator::StochasticDiffusionAmountCalculator
                                      (ImportanceIndex* imp) :
     _imidx(imp)
 {
+    int64_t start = now();
+    for (BinRecord& bin : _bins) {
+        bin.count = 0;
+        bin.update_rate = 0.0f;
+        bin.last_update = start;
+    }
 }
 
 /**
@@ -112,28 +113,14 @@ float StochasticDiffusionAmountCalculator::elapsed_time(const Handle& h)
 {
     float average_elapsed_time = 0.0f;
 
-    auto index = bin_index(h);
-    auto it = std::find_if(_bins.begin(), _bins.end(),
-            [index](const DiffusionRecordBin& b){ return (b.index == index); });
+    size_t index = bin_index(h);
+    const BinRecord& bin = _bins[index];
+    float update_rate = bin.update_rate.load(std::memory_order_relaxed);
 
-    if (it != _bins.end())
-        average_elapsed_time = (*it).size / (*it).update_rate;
+    if (0.0f < update_rate)
+        average_elapsed_time = bin_size(index) / update_rate;
 
-    update_bin(h); // Update DiffusionRecordBin.
+    update_bin(index, now()); // Update the diffusion record of this bin.
 
     return average_elapsed_time;
 }
-
-/**
- *  Calculates estimated current STI value of the handle after diffusion.
- *  @param h A handle
- *  @param decay_rate percentage decay parameter
- *
- *  @returns the calculated current STI after diffusion.
- */
-float StochasticDiffusionAmountCalculator::diffused_value(const Handle& h,
-                                                          float decay_rate)
-{
-    float average_elapsed_time = elapsed_time(h);
-    return get_sti(h) * pow((1 - decay_rate), average_elapsed_time);
-}
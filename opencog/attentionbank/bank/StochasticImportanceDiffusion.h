@@ -26,14 +26,18 @@
 #define _OPENCOG_STOCHASTIC_DIFFUSION_H
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <vector>
 
+#include <opencog/attentionbank/bank/DiffusionAmountCalculator.h>
+#include <opencog/attentionbank/bank/ImportanceIndex.h>
+
 using namespace std::chrono;
 namespace opencog
 {
     class Handle;
-    class ImportantIndex;
     namespace ecan
     {
         struct DiffusionRecordBin {
@@ -58,15 +62,28 @@ namespace opencog
          * particular bin. Then the average elapsed time since last diffusion event
          * for an atom will be claculated as total in the bin divided by update rate
          * (count of diffused atoms divided by duration of time).
+         *
+         * The diffusion bins are in one-to-one correspondence with the bins
+         * of the ImportanceIndex. All bookkeeping is done with atomics, so a
+         * single instance may be shared by several agent threads.
          */
         class StochasticDiffusionAmountCalculator
+            : public DiffusionAmountCalculator
         {
+            struct BinRecord {
+                std::atomic<unsigned int> count;
+                std::atomic<float> update_rate;
+                std::atomic<int64_t> last_update; // nanoseconds
+            };
+
             ImportanceIndex* _imidx;
-            std::vector<DiffusionRecordBin> _bins; 
+            std::array<BinRecord, ImportanceIndex::NUM_BINS> _bins;
+
+            static int64_t now(void);
 
             size_t bin_index(const Handle&);
             size_t bin_size(unsigned int index);
-            void update_bin(const Handle&);
+            void update_bin(size_t index, int64_t now);
 
         public:
             StochasticDiffusionAmountCalculator(ImportanceIndex*);
@@ -75,7 +92,6 @@ namespace opencog
                     const std::vector<DiffusionRecordBin>& past,
                     std::vector<DiffusionRecordBin>& recent,
                     float bias);
-            float diffused_value(const Handle& h, float decay_rate);
             float elapsed_time(const Handle& h);
         };
     }